@@ -0,0 +1,23 @@
+: Half of a gap junction. The other side's voltage arrives in vgap
+: by way of ParallelContext.source_var/target_var.
+
+NEURON {
+	THREADSAFE
+	POINT_PROCESS HalfGap
+	NONSPECIFIC_CURRENT i
+	RANGE g, i, vgap
+}
+
+PARAMETER {
+	g = 0 (microsiemens)
+}
+
+ASSIGNED {
+	v (millivolt)
+	vgap (millivolt)
+	i (nanoamp)
+}
+
+BREAKPOINT {
+	i = g*(v - vgap)
+}
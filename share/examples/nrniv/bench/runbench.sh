@@ -0,0 +1,78 @@
+#!/bin/sh
+# Run the bench.hoc models over integration methods, thread counts and
+# rank counts and append one JSON object per run to the output file.
+# Compiles halfgap.mod (for the gap junction model) in the current
+# directory, so run from a scratch directory.
+#
+# runbench.sh [-b bindir] [-o outfile] [-m models] [-e methods]
+#	[-t threads] [-r ranks] [-c ncell] [-s tstop] [-x mpiexec]
+# e.g. runbench.sh -b /usr/local/nrn/x86_64/bin -t "1 2 4" -r "1 2"
+# models: 0 ring, 1 random balanced network, 2 gap junctions
+# methods: 0 fixed step, 1 global variable step, 2 local variable step
+
+bindir=""
+out=bench.jsonl
+models="0 1 2"
+methods="0 1 2"
+threads="1 2"
+ranks="1"
+ncell=0
+tstop=100
+mpiexec=mpiexec
+
+while getopts b:o:m:e:t:r:c:s:x: opt ; do
+	case $opt in
+	b) bindir="$OPTARG/" ;;
+	o) out="$OPTARG" ;;
+	m) models="$OPTARG" ;;
+	e) methods="$OPTARG" ;;
+	t) threads="$OPTARG" ;;
+	r) ranks="$OPTARG" ;;
+	c) ncell="$OPTARG" ;;
+	s) tstop="$OPTARG" ;;
+	x) mpiexec="$OPTARG" ;;
+	*) sed -n '2,13p' "$0" ; exit 1 ;;
+	esac
+done
+
+srcdir=`dirname "$0"`
+if [ "`cd "$srcdir" && pwd`" != "`pwd`" ] ; then
+	cp "$srcdir"/*.hoc "$srcdir"/halfgap.mod .
+fi
+
+if ! "${bindir}nrnivmodl" > nrnivmodl.log 2>&1 ; then
+	echo "nrnivmodl failed, see nrnivmodl.log" 1>&2
+	exit 1
+fi
+special=`ls */special | head -1`
+
+status=0
+for model in $models ; do
+for method in $methods ; do
+	if [ $model = 2 -a $method = 2 ] ; then
+		continue # local variable step does not support gap junctions
+	fi
+for np in $ranks ; do
+for nt in $threads ; do
+	if [ $model = 2 -a $method = 1 -a $np -gt 1 -a $nt -gt 1 ] ; then
+		continue # global variable step cannot combine threads and ranks here
+	fi
+	args="-c MODEL=$model -c METHOD=$method -c NTHREAD=$nt -c NCELL=$ncell -c TSTOP=$tstop bench.hoc"
+	if [ $np -gt 1 ] ; then
+		cmd="$mpiexec -n $np $special -mpi $args"
+	else
+		cmd="$special $args"
+	fi
+	line=`$cmd 2>&1 | sed -n 's/^BENCH //p'`
+	if [ -z "$line" ] ; then
+		echo "failed: $cmd" 1>&2
+		status=1
+	else
+		echo "$line" >> "$out"
+		echo "$line"
+	fi
+done
+done
+done
+done
+exit $status
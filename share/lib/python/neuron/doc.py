@@ -311,6 +311,19 @@ See:
 
 http://neuron.yale.edu/neuron/static/docs/help/neuron/neuron/classes/parcon.html
 
+Note:
+
+Changing the model between runs. Inserting or uninserting a density
+mechanism, or creating, destroying or relocating a point process, in a
+section that was already part of the simulation only rebuilds the
+mechanism lists of the thread that owns it. Every other structure
+change takes the full setup, as before: creating or deleting a section
+or cell, connecting or disconnecting sections, changing nseg,
+extracellular, artificial cells, and any change to pc.nthread. So
+building a network a cell at a time, with a run or finitialize after
+each cell, is not any faster. Create all the cells before the first
+run.
+
 """,
     NetStim = """
 
@@ -418,6 +431,20 @@ obj2.to_python(obj1)
   writes obj2 to obj1
 obj2.from_python(obj1)
   fills obj2 with the contents of obj1
+obj2.from_buffer(obj1)
+  fills obj2 with one copy from obj1, which must expose a buffer of
+  doubles (e.g. a float64 numpy array)
+
+Buffer protocol
+
+a = numpy.frombuffer(obj2)
+m = memoryview(obj2)
+  Vector and full Matrix objects export their data as 1-d and 2-d
+  buffers of doubles without copying. Other hoc objects do not support
+  the buffer protocol. While a buffer is in use, growing the Vector
+  beyond its buffer_size (resize, append, record, buffer_size, mmap,
+  ...) or changing the size of the Matrix raises an error. Release the
+  buffer (e.g. del the numpy array) first.
 
   
 DESCRIPTION
@@ -8,6 +8,10 @@ $Id$
 # import your specific test here
 # and add it to the "suite" function below
 from neuron.tests import test_vector
+from neuron.tests import test_rangevar
+from neuron.tests import test_netcon
+from neuron.tests import test_cellload
+from neuron.tests import test_spikestats
 
 import unittest
 
@@ -16,6 +20,10 @@ def suite():
     
     suite = unittest.TestSuite()
     suite.addTest(test_vector.suite())
+    suite.addTest(test_rangevar.suite())
+    suite.addTest(test_netcon.suite())
+    suite.addTest(test_cellload.suite())
+    suite.addTest(test_spikestats.suite())
     # add additional test cases here
     return suite
 
@@ -0,0 +1,79 @@
+"""
+UnitTests of CellLoader, bulk cell construction from a binary file.
+
+$Id$
+"""
+
+import os
+import tempfile
+import unittest
+from neuron import h
+
+h('''
+begintemplate TestCellLoaderCell
+public sec
+create sec[1]
+proc init() {
+	$o1.build($2, "sec")
+}
+endtemplate TestCellLoaderCell
+''')
+
+class CellLoaderTestCase(unittest.TestCase):
+    """Tests of CellLoader.write and CellLoader.build"""
+
+    def setUp(self):
+        fd, self.fname = tempfile.mkstemp(suffix='.dat')
+        os.close(fd)
+        self.soma = h.Section(name='clsoma')
+        self.dend = h.Section(name='cldend')
+        self.dend.connect(self.soma(1))
+        self.soma.insert('hh')
+        self.dend.nseg = 5
+        self.dend.insert('pas')
+        self.sl = h.SectionList()
+        self.sl.append(sec=self.soma)
+        self.sl.append(sec=self.dend)
+
+    def tearDown(self):
+        os.remove(self.fname)
+        self.sl = None
+        self.dend = None
+        self.soma = None
+
+    def build(self):
+        h.CellLoader().write(self.fname, self.sl)
+        return h.TestCellLoaderCell(h.CellLoader(self.fname), 0)
+
+    def testNonUniform(self):
+        """Values that differ between segments are kept per segment"""
+
+        for i, seg in enumerate(self.dend):
+            seg.g_pas = .0001*(2*i + 1)
+            seg.diam = 5 - i
+        cell = self.build()
+        for seg, seg1 in zip(self.dend, cell.sec[1]):
+            assert seg1.g_pas == seg.g_pas
+            assert seg1.diam == seg.diam
+        assert cell.sec[0](.5).gnabar_hh == self.soma(.5).gnabar_hh
+
+    def testPointProcesses(self):
+        """Point processes on a node are not written"""
+
+        syns = [h.ExpSyn(.5, sec=self.soma) for i in range(200)]
+        cell = self.build()
+        assert cell.sec[0](.5).gkbar_hh == self.soma(.5).gkbar_hh
+        assert len(list(cell.sec[0](.5).point_processes())) == 0
+
+
+def suite():
+
+    suite = unittest.makeSuite(CellLoaderTestCase,'test')
+    return suite
+
+
+if __name__ == "__main__":
+
+    # unittest.main()
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,91 @@
+"""
+UnitTests of compact NetCon, CVode.netcon_compact.
+
+$Id$
+"""
+
+import unittest
+from neuron import h
+
+# netcon_compact_remove refuses while anything references a compact
+# NetCon. A hoc method called from Python can leave a reference in a hoc
+# temporary, so the NetCon, and Lists holding them, are only used in hoc
+# statements through these object variables.
+h('objref tnc_cvode, tnc_pc, tnc_stim, tnc_syns, tnc_ncl, tnc_nc, tnc_tar, nil')
+
+class NetConCompactTestCase(unittest.TestCase):
+    """Tests of CVode.netcon_compact and netcon_compact_remove"""
+
+    def setUp(self):
+        self.soma = h.Section(name='ncsoma')
+        h.tnc_cvode = h.CVode()
+        h.tnc_pc = h.ParallelContext()
+        h.tnc_stim = h.NetStim(0.5, sec=self.soma)
+        h.tnc_syns = h.List()
+        for i in range(3):
+            h.tnc_syns.append(h.ExpSyn(0.5, sec=self.soma))
+        n = h.tnc_cvode.netcon_compact(h.tnc_stim, h.tnc_syns,
+                                       h.Vector(1).fill(1),
+                                       h.Vector([.1, .2, .3]))
+        assert n == 3
+
+    def tearDown(self):
+        h('objref tnc_ncl, tnc_nc')
+        h.tnc_cvode.netcon_compact_remove()
+        h.tnc_pc.gid_clear()  # before the source of a gid is freed
+        h('objref tnc_cvode, tnc_pc, tnc_stim, tnc_syns, tnc_tar')
+        self.soma = None
+
+    def count(self, src):
+        h('{tnc_ncl = new List() tnc_cvode.netconlist(%s, "", "", tnc_ncl)'
+          ' hoc_ac_ = tnc_ncl.count() objref tnc_ncl}' % src)
+        return h.hoc_ac_
+
+    def testRetarget(self):
+        """A compact NetCon keeps its weights or refuses a new count"""
+
+        h('{tnc_ncl = new List() tnc_cvode.netconlist(tnc_stim, "", "", tnc_ncl)}')
+        h('{tnc_nc = tnc_ncl.object(1)  objref tnc_ncl}')
+        h.tnc_tar = h.ExpSyn(0.5, sec=self.soma)
+        h('{tnc_nc.setpost(tnc_tar)  hoc_ac_ = tnc_nc.syn() == tnc_tar}')
+        assert h.hoc_ac_ == 1
+        h('hoc_ac_ = tnc_nc.weight')
+        assert abs(h.hoc_ac_ - .2) < 1e-12
+        # an IClamp has no NET_RECEIVE and so no weights
+        h.tnc_tar = h.IClamp(0.5, sec=self.soma)
+        assert h.execute1('tnc_nc.setpost(tnc_tar)') == 0
+        h('hoc_ac_ = tnc_nc.weight')
+        assert abs(h.hoc_ac_ - .2) < 1e-12
+        h('objref tnc_nc, tnc_tar')
+        h.tnc_cvode.netcon_compact_remove()
+        assert self.count('tnc_stim') == 0
+
+    def testReplaceSource(self):
+        """netcon_compact_remove also removes NetCon moved to another source"""
+
+        h.tnc_tar = h.NetStim(0.5, sec=self.soma)
+        h('{tnc_pc.set_gid2node(7, tnc_pc.id)}')
+        h('{tnc_pc.cell(7, new NetCon(tnc_tar, nil))}')
+        assert self.count('tnc_tar') == 0  # only NetCon with a target
+        h('{tnc_ncl = new List() tnc_cvode.netconlist(tnc_stim, "", "", tnc_ncl)}')
+        h('{tnc_nc = tnc_ncl.object(2)  objref tnc_ncl}')
+        h('{tnc_nc = tnc_pc.gid_connect(7, tnc_syns.object(2), tnc_nc)}')
+        h('hoc_ac_ = tnc_nc.srcgid()')
+        assert h.hoc_ac_ == 7
+        assert self.count('tnc_tar') == 1
+        h('objref tnc_nc')
+        h.tnc_cvode.netcon_compact_remove()
+        assert self.count('tnc_stim') == 0
+        assert self.count('tnc_tar') == 0
+
+def suite():
+
+    suite = unittest.makeSuite(NetConCompactTestCase,'test')
+    return suite
+
+
+if __name__ == "__main__":
+
+    # unittest.main()
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -0,0 +1,68 @@
+"""
+UnitTests of bulk range variable access, nrn.rangevar_get and rangevar_set.
+
+$Id$
+"""
+
+import unittest
+from neuron import h, nrn
+
+class RangeVarTestCase(unittest.TestCase):
+    """Tests of nrn.rangevar_get and nrn.rangevar_set"""
+
+    def setUp(self):
+        self.secs = [h.Section(name='rv%d' % i) for i in range(4)]
+        self.sl = h.SectionList()
+        for i, sec in enumerate(self.secs):
+            sec.nseg = 3
+            sec.insert('hh')
+            if i % 2 == 0:
+                self.sl.append(sec=sec)
+
+    def tearDown(self):
+        self.sl = None
+        self.secs = None
+
+    def testScalar(self):
+        """Assign one value to every segment of a SectionList"""
+
+        nrn.rangevar_set('gnabar_hh', 0.25, self.sl)
+        v = nrn.rangevar_get('gnabar_hh', self.sl)
+        assert v.size() == 6
+        assert v.min() == 0.25 and v.max() == 0.25
+        assert self.secs[1](0.5).gnabar_hh == 0.12
+
+    def testSequence(self):
+        """Values are in section order then segment order"""
+
+        nrn.rangevar_set('gkbar_hh', h.Vector(6).indgen(), self.sl)
+        assert self.secs[2](0.5).gkbar_hh == 4.
+        nrn.rangevar_set('diam', [1., 2., 3.], self.secs[3])
+        assert list(nrn.rangevar_get('diam', [self.secs[3]])) == [1., 2., 3.]
+        self.assertRaises(ValueError, nrn.rangevar_set, 'gkbar_hh', [1.],
+                          self.sl)
+        self.assertRaises(NameError, nrn.rangevar_get, 'gbar_nosuch')
+
+    def testReversed(self):
+        """Segment order is 0 to 1 for a section connected at its 1 end"""
+
+        child = self.secs[1]
+        child.connect(self.secs[0](1), 1)
+        nrn.rangevar_set('gnabar_hh', [1., 2., 3.], child)
+        assert [child(x).gnabar_hh for x in (1./6, .5, 5./6)] == [1., 2., 3.]
+        nrn.rangevar_set('diam', [4., 5., 6.], child)
+        assert list(nrn.rangevar_get('gnabar_hh', [child])) == [1., 2., 3.]
+        assert list(nrn.rangevar_get('diam', [child])) == [4., 5., 6.]
+
+
+def suite():
+
+    suite = unittest.makeSuite(RangeVarTestCase,'test')
+    return suite
+
+
+if __name__ == "__main__":
+
+    # unittest.main()
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
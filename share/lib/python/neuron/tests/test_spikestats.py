@@ -0,0 +1,61 @@
+"""
+UnitTests of SpikeStats histograms.
+
+$Id$
+"""
+
+import unittest
+from neuron import h
+
+class SpikeStatsTestCase(unittest.TestCase):
+    """Tests of SpikeStats.isihist, psth and xcorr"""
+
+    def setUp(self):
+        # gid 0 spikes at 1, 2, 4.5, 10 and gid 1 at 3, 3.5, unsorted as
+        # from spike_record
+        tvec = h.Vector([1, 2, 3, 3.5, 4.5, 10])
+        idvec = h.Vector([0, 0, 1, 1, 0, 0])
+        self.ss = h.SpikeStats(tvec, idvec)
+        self.y = h.Vector()
+
+    def tearDown(self):
+        self.ss = None
+        self.y = None
+
+    def testIsihist(self):
+        """intervals 1, 2.5, 5.5 and .5 in bins of width 1"""
+
+        self.ss.isihist(self.y, 1, 6)
+        assert list(self.y) == [1., 1., 1., 0., 0., 1.]
+
+    def testPsth(self):
+        """[tstart, tstop) in bins of width 2, the spike at 10 is out"""
+
+        self.ss.psth(self.y, 2, 0, 10)
+        assert list(self.y) == [1., 3., 1., 0., 0.]
+
+    def testXcorr(self):
+        """lags 1, 1.5, -1.5, -1 of gid 1 relative to gid 0 in [-2, 2)"""
+
+        self.ss.xcorr(self.y, 0, 1, 1, 2)
+        assert list(self.y) == [1., 1., 0., 2.]
+
+    def testTooManyBins(self):
+        """a tiny bin width is an error, not a huge allocation"""
+
+        self.assertRaises(RuntimeError, self.ss.isihist, self.y, 1e-9, 1e9)
+        self.assertRaises(RuntimeError, self.ss.psth, self.y, 1e-9, 0, 1e9)
+        self.assertRaises(RuntimeError, self.ss.xcorr, self.y, 0, 1, 1e-9, 1e9)
+
+
+def suite():
+
+    suite = unittest.makeSuite(SpikeStatsTestCase,'test')
+    return suite
+
+
+if __name__ == "__main__":
+
+    # unittest.main()
+    runner = unittest.TextTestRunner(verbosity=2)
+    runner.run(suite())
@@ -91,6 +91,65 @@ class VectorTestCase(unittest.TestCase):
 
         # todo
 
+    def testBuffer(self):
+        """Testing the buffer protocol and Vector.from_buffer"""
+
+        import numpy
+
+        v = h.Vector(numpy.arange(5.))
+        a = numpy.frombuffer(v)
+        a[2] = 10.
+        assert v.x[2] == 10., 'buffer does not share Vector data'
+        assert memoryview(v).shape == (5,)
+
+        # no reallocation while the data is shared
+        self.assertRaises(RuntimeError, v.resize, 1000)
+        del a
+        v.resize(1000)
+
+        b = numpy.random.normal(size=1000)
+        v.from_buffer(b)
+        assert numpy.alltrue(numpy.array(v) == b)
+        v.from_buffer(b[::-2])
+        assert numpy.alltrue(numpy.array(v) == b[::-2])
+
+        m = h.Matrix(3, 4)
+        m.setval(2, 3, 5.)
+        am = numpy.asarray(memoryview(m))
+        assert am.shape == (3, 4) and am[2, 3] == 5.
+        self.assertRaises(RuntimeError, m.resize, 4, 4)
+        del am
+        m.resize(4, 4)
+
+        # a simple (not PyBUF_ND) view of a Matrix is 1-d
+        b = bytearray(memoryview(m).cast('B'))
+        assert len(b) == 16 * 8
+
+        # only Vector and Matrix have the buffer protocol
+        self.assertRaises(TypeError, memoryview, h.List())
+
+    def testMmap(self):
+        """Testing Vector.mmap followed by buffer_size"""
+
+        import array, os, tempfile
+
+        fd, fname = tempfile.mkstemp()
+        f = os.fdopen(fd, 'wb')
+        array.array('d', range(10)).tofile(f)
+        f.close()
+        v = h.Vector()
+        try:
+            v.mmap(fname)
+        except RuntimeError: # no mmap on this platform
+            os.remove(fname)
+            return
+        assert v.size() == 10 and v.sum() == 45.
+        v.buffer_size(100)
+        assert v.size() == 10 and v.sum() == 45.
+        assert v.buffer_size() == 100
+        v = None
+        os.remove(fname)
+
 
 def suite():
 
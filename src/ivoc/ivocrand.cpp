@@ -10,6 +10,7 @@
 #include "classreg.h"
 #include "oc2iv.h"
 #include "nrnisaac.h"
+#include "ivocvect.h"
 
 #include <OS/list.h>
 #include <ocnotify.h>
@@ -41,6 +42,7 @@
 #define dmaxuint 4294967295.
 
 extern "C" {void nrn_random_play(); }
+
 class RandomPlay : public Observer, public Resource {
 public:
 	RandomPlay(Rand*, double*);
@@ -195,9 +197,16 @@ Rand::Rand(unsigned long seed, int size, Object* obj) {
    gen = new ACG(seed,size);
    rand = new Normal(0.,1.,gen); 
    type_ = 0;
+   dist_ = RD_NORMAL;
    obj_ = obj;
 }
 
+void Rand::distribution(Random* r, int dist) {
+   delete rand;
+   rand = r;
+   dist_ = dist;
+}
+
 Rand::~Rand() {
 //printf("~Rand\n");
   delete gen;
@@ -410,8 +419,7 @@ static double r_uniform(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new Uniform(a1, a2, x->gen);
+  x->distribution(new Uniform(a1, a2, x->gen), Rand::RD_UNIFORM);
   return (*(x->rand))();
 }
 
@@ -424,8 +432,7 @@ static double r_discunif(void* r)
   Rand* x = (Rand*)r;
   long a1 = long(*getarg(1));
   long a2 = long(*getarg(2));
-  delete x->rand;
-  x->rand = new DiscreteUniform(a1, a2, x->gen);
+  x->distribution(new DiscreteUniform(a1, a2, x->gen), Rand::RD_DISCUNIF);
   return (*(x->rand))();
 }
 
@@ -439,8 +446,7 @@ static double r_normal(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new Normal(a1, a2, x->gen);
+  x->distribution(new Normal(a1, a2, x->gen), Rand::RD_NORMAL);
   return (*(x->rand))();
 }
 
@@ -454,8 +460,7 @@ static double r_lognormal(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new LogNormal(a1, a2, x->gen);
+  x->distribution(new LogNormal(a1, a2, x->gen), Rand::RD_LOGNORMAL);
   return (*(x->rand))();
 }
 
@@ -468,8 +473,7 @@ static double r_poisson(void* r)
 {
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
-  delete x->rand;
-  x->rand = new Poisson(a1, x->gen);
+  x->distribution(new Poisson(a1, x->gen));
   return (*(x->rand))();
 }
 
@@ -485,8 +489,7 @@ static double r_binomial(void* r)
   Rand* x = (Rand*)r;
   int a1 = int(chkarg(1, 0, 1e99));
   double a2 = chkarg(2, 0, 1);
-  delete x->rand;
-  x->rand = new Binomial(a1, a2, x->gen);
+  x->distribution(new Binomial(a1, a2, x->gen));
   return (*(x->rand))();
 }
 
@@ -502,8 +505,7 @@ static double r_geometric(void* r)
 {
   Rand* x = (Rand*)r;
   double a1 = chkarg(1, 0, 1);
-  delete x->rand;
-  x->rand = new Geometric(a1, x->gen);
+  x->distribution(new Geometric(a1, x->gen));
   return (*(x->rand))();
 }
 
@@ -518,8 +520,7 @@ static double r_hypergeo(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new HyperGeometric(a1, a2, x->gen);
+  x->distribution(new HyperGeometric(a1, a2, x->gen));
   return (*(x->rand))();
 }
 
@@ -532,8 +533,7 @@ static double r_negexp(void* r)
 {
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
-  delete x->rand;
-  x->rand = new NegativeExpntl(a1, x->gen);
+  x->distribution(new NegativeExpntl(a1, x->gen), Rand::RD_NEGEXP);
   return (*(x->rand))();
 }
 
@@ -548,8 +548,7 @@ static double r_erlang(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new Erlang(a1, a2, x->gen);
+  x->distribution(new Erlang(a1, a2, x->gen));
   return (*(x->rand))();
 }
 
@@ -563,11 +562,103 @@ static double r_weibull(void* r)
   Rand* x = (Rand*)r;
   double a1 = *getarg(1);
   double a2 = *getarg(2);
-  delete x->rand;
-  x->rand = new Weibull(a1, a2, x->gen);
+  x->distribution(new Weibull(a1, a2, x->gen));
   return (*(x->rand))();
 }
 
+// Fill a Vector with draws from the current distribution.
+// syntax:
+//     r.fill(vec)
+//     r.fill(vec, idvec)
+// With a Random123 generator and the uniform, discunif, normal, lognormal,
+// or negexp distribution the values are computed in bulk from whole
+// counter blocks (see nrnran123_array). Otherwise the result is the same
+// as vec.setrand(r).
+// With idvec (Random123 only), vec.x[i] is a draw from the stream
+// (idvec.x[i], id2, id3) at the current sequence, which then advances by
+// one block. Those values depend only on the identifiers, the sequence,
+// and the global index, so e.g. per synapse noise keyed by gid is the
+// same whichever rank or thread owns the synapse.
+
+static double r_fill(void* r)
+{
+  Rand* x = (Rand*)r;
+  Vect* v = vector_arg(1);
+  int i, n = v->capacity();
+  double* px = v->vec();
+  int dist;
+  switch (x->dist_) {
+  case Rand::RD_UNIFORM: case Rand::RD_DISCUNIF: dist = NRNRAN123_UNIFORM; break;
+  case Rand::RD_NORMAL: case Rand::RD_LOGNORMAL: dist = NRNRAN123_NORMAL; break;
+  case Rand::RD_NEGEXP: dist = NRNRAN123_NEGEXP; break;
+  default: dist = -1; break;
+  }
+  if (x->type_ != 4 || dist < 0) {
+    if (ifarg(2)) {
+hoc_execerror("Random.fill with an id Vector requires Random123 and", "a uniform, discunif, normal, lognormal, or negexp distribution");
+    }
+    for (i=0; i < n; ++i) {
+      px[i] = (*(x->rand))();
+    }
+    return double(n);
+  }
+  nrnran123_State* s = ((NrnRandom123*)x->gen)->s_;
+  if (ifarg(2)) {
+    Vect* vid = vector_arg(2);
+    if (vid->capacity() != n) {
+      hoc_execerror("Random.fill", "Vector arguments must have the same size");
+    }
+    uint32_t seq, id1, id2, id3;
+    char which;
+    nrnran123_getseq(s, &seq, &which);
+    if (which) {
+      ++seq;
+    }
+    nrnran123_getids3(s, &id1, &id2, &id3);
+    uint32_t ids[1024];
+    for (int i0 = 0; i0 < n; i0 += 1024) {
+      int m = (n - i0 < 1024) ? n - i0 : 1024;
+      for (i=0; i < m; ++i) {
+        ids[i] = (uint32_t)vid->elem(i0 + i);
+      }
+      nrnran123_streams(seq, ids, id2, id3, dist, px + i0, m);
+    }
+    nrnran123_setseq(s, seq + 1, 0);
+  }else{
+    nrnran123_array(s, dist, px, n);
+  }
+  switch (x->dist_) {
+  case Rand::RD_UNIFORM: {
+    Uniform* d = (Uniform*)x->rand;
+    double a = d->low(), b = d->high() - d->low();
+    for (i=0; i < n; ++i) { px[i] = a + b*px[i]; }
+    }break;
+  case Rand::RD_DISCUNIF: {
+    DiscreteUniform* d = (DiscreteUniform*)x->rand;
+    double a = double(d->low()), b = double(d->high() - d->low() + 1);
+    for (i=0; i < n; ++i) { px[i] = a + floor(b*px[i]); }
+    }break;
+  case Rand::RD_NORMAL: {
+    Normal* d = (Normal*)x->rand;
+    double a = d->mean(), b = sqrt(d->variance());
+    for (i=0; i < n; ++i) { px[i] = a + b*px[i]; }
+    }break;
+  case Rand::RD_LOGNORMAL: {
+    // parameters of the underlying normal, as in LogNormal::setState
+    LogNormal* d = (LogNormal*)x->rand;
+    double m2 = d->mean() * d->mean();
+    double a = log(m2 / sqrt(d->variance() + m2));
+    double b = sqrt(log((d->variance() + m2)/m2));
+    for (i=0; i < n; ++i) { px[i] = exp(a + b*px[i]); }
+    }break;
+  case Rand::RD_NEGEXP: {
+    double a = ((NegativeExpntl*)x->rand)->mean();
+    for (i=0; i < n; ++i) { px[i] *= a; }
+    }break;
+  }
+  return double(n);
+}
+
 static double r_play(void* r){
 	new RandomPlay((Rand*)r, hoc_pgetarg(1));
 	return 0.;
@@ -602,6 +693,7 @@ static Member_func r_members[] = {
 	"erlang",           r_erlang,
 	"weibull",          r_weibull,
 	"play",		r_play,
+	"fill",		r_fill,
  	0, 0
 };
 
@@ -10,6 +10,12 @@
 #include <ivstream.h>
 #include <math.h>
 #include <errno.h>
+#if HAVE_MMAP
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 #include <OS/math.h>
 #include "fourier.h"
@@ -96,12 +102,14 @@ static double dmaxint_;
 #include "oc2iv.h"
 #include "parse.h"
 #include "ocfile.h"
+#include "vecexpr.h"
 
 extern "C" {
 extern Object* hoc_thisobject;
 extern Symlist* hoc_top_level_symlist;
 extern void nrn_exit(int);
 IvocVect* (*nrnpy_vec_from_python_p_)(void*);
+IvocVect* (*nrnpy_vec_from_buffer_p_)(void*);
 Object** (*nrnpy_vec_to_python_p_)(void*);
 Object** (*nrnpy_vec_as_numpy_helper_)(int, double*);
 };
@@ -130,6 +138,141 @@ static int narg() {
 
 #define EPSILON 1e-9
 
+// Bulk arithmetic and reductions on long vectors are split into
+// contiguous chunks, one per worker thread, when ParallelContext.nthread
+// has started the pthread pool. The hook is set by nrn_threads_create in
+// nrnoc/multicore.c. (*nrn_vec_multithread_p_)(job) calls job(i, n) for
+// i = 0..n-1 concurrently and returns n, or returns 0 if the pool is not
+// usable. A null job only queries n. Partial results are combined in
+// thread order, so a threaded sum is reproducible for a given number of
+// threads but may differ from the serial sum in the last bits.
+extern "C" {
+int (*nrn_vec_multithread_p_)(void (*job)(int, int));
+}
+
+#define VEC_MT_MIN 100000
+
+enum { VJ_SUM, VJ_SUMSQ, VJ_SSD, VJ_DOT, VJ_ADD, VJ_SUB, VJ_MUL, VJ_DIV,
+	VJ_ADDS, VJ_SUBS, VJ_MULS, VJ_DIVS, VJ_AFFINE, VJ_HIST };
+
+static struct VecJob {
+	int op;
+	double* x;
+	const double* y;
+	double a, b, c;
+	int n;
+	int nth;
+	int nbucket;
+	double* part; // nth partial results or nth*nbucket histogram counts
+	int partsize;
+} vecjob_;
+
+static double vec_kernel(int i0, int i1, double* hist) {
+	VecJob& j = vecjob_;
+	double* x = j.x;
+	const double* y = j.y;
+	double a = j.a, b = j.b, c = j.c, s = 0.;
+	int k;
+	switch (j.op) {
+	case VJ_SUM: for (k=i0; k < i1; ++k) { s += x[k]; } break;
+	case VJ_SUMSQ: for (k=i0; k < i1; ++k) { s += x[k]*x[k]; } break;
+	case VJ_SSD: for (k=i0; k < i1; ++k) { s += (x[k] - a)*(x[k] - a); } break;
+	case VJ_DOT: for (k=i0; k < i1; ++k) { s += x[k]*y[k]; } break;
+	case VJ_ADD: for (k=i0; k < i1; ++k) { x[k] += y[k]; } break;
+	case VJ_SUB: for (k=i0; k < i1; ++k) { x[k] -= y[k]; } break;
+	case VJ_MUL: for (k=i0; k < i1; ++k) { x[k] *= y[k]; } break;
+	case VJ_DIV: for (k=i0; k < i1; ++k) { x[k] /= y[k]; } break;
+	case VJ_ADDS: for (k=i0; k < i1; ++k) { x[k] += a; } break;
+	case VJ_SUBS: for (k=i0; k < i1; ++k) { x[k] -= a; } break;
+	case VJ_MULS: for (k=i0; k < i1; ++k) { x[k] *= a; } break;
+	case VJ_DIVS: for (k=i0; k < i1; ++k) { x[k] /= a; } break;
+	case VJ_AFFINE: for (k=i0; k < i1; ++k) { x[k] = (x[k] - a)*b + c; } break;
+	case VJ_HIST:
+		// a is low, b is width
+		for (k=i0; k < i1; ++k) {
+			int ind = int(floor((x[k] - a)/b)) + 1;
+			if (ind >= 0 && ind < j.nbucket) {
+				hist[ind] += 1.0;
+			}
+		}
+		break;
+	}
+	return s;
+}
+
+static void vec_job(int i, int nth) {
+	VecJob& j = vecjob_;
+	int i0 = int((long)j.n * i / nth);
+	int i1 = int((long)j.n * (i + 1) / nth);
+	if (j.op == VJ_HIST) {
+		vec_kernel(i0, i1, j.part + i*j.nbucket);
+	}else{
+		j.part[i] = vec_kernel(i0, i1, NULL);
+	}
+}
+
+// Number of threads vec_op would use for n elements, < 2 means serial.
+static int vec_nthread(int n) {
+	if (n >= VEC_MT_MIN && nrn_vec_multithread_p_) {
+		return (*nrn_vec_multithread_p_)(NULL);
+	}
+	return 0;
+}
+
+// Returns the result of a reduction op. For the element-wise ops x is
+// modified in place. For VJ_HIST, hist (nbucket counts) is incremented.
+static double vec_op(int op, int n, double* x, const double* y = NULL,
+  double a = 0., double b = 0., double c = 0.,
+  double* hist = NULL, int nbucket = 0
+) {
+	VecJob& j = vecjob_;
+	j.op = op; j.n = n; j.x = x; j.y = y; j.a = a; j.b = b; j.c = c;
+	j.nbucket = nbucket;
+	int nth = vec_nthread(n);
+	if (nth < 2) {
+		return vec_kernel(0, n, hist);
+	}
+	int size = (op == VJ_HIST) ? nth*nbucket : nth;
+	if (size > j.partsize) {
+		delete [] j.part;
+		j.partsize = size;
+		j.part = new double[size];
+	}
+	j.nth = nth;
+	if (op == VJ_HIST) {
+		for (int i=0; i < size; ++i) {
+			j.part[i] = 0.;
+		}
+	}
+	(*nrn_vec_multithread_p_)(vec_job);
+	double s = 0.;
+	if (op == VJ_HIST) {
+		for (int i=0; i < nth; ++i) {
+			double* h = j.part + i*nbucket;
+			for (int k=0; k < nbucket; ++k) {
+				hist[k] += h[k];
+			}
+		}
+	}else{
+		for (int i=0; i < nth; ++i) {
+			s += j.part[i];
+		}
+	}
+	return s;
+}
+
+// Variance of x[start..end]. The serial path is the ParentVect::var
+// computation so results do not change unless the pool is running.
+static double vec_var(Vect* x, int start, int end) {
+	int n = end - start + 1;
+	if (vec_nthread(n) < 2) {
+		return x->subvec(start, end)->var();
+	}
+	double* px = x->vec() + start;
+	double m = vec_op(VJ_SUM, n, px)/n;
+	return vec_op(VJ_SSD, n, px, NULL, m)/(n - 1);
+}
+
 extern "C" {
 	extern void notify_freed_val_array(double*, size_t);
 	extern void install_vector_method(const char* name, Pfrd_vp);
@@ -138,10 +281,10 @@ extern "C" {
         extern int nrn_mlh_gsort (double* vec, int *base_ptr, int total_elems, doubleComparator cmp);
 };
 
-IvocVect::IvocVect(Object* o) : ParentVect(){obj_ = o; label_ = NULL; MUTCONSTRUCT(0)}
-IvocVect::IvocVect(int l, Object* o) : ParentVect(l){obj_ = o; label_ = NULL; MUTCONSTRUCT(0)}
-IvocVect::IvocVect(int l, double fill_value, Object* o) : ParentVect(l, fill_value){obj_ = o; label_ = NULL; MUTCONSTRUCT(0)}
-IvocVect::IvocVect(IvocVect& v, Object* o) : ParentVect(v) {obj_ = o; label_ = NULL; MUTCONSTRUCT(0)}
+IvocVect::IvocVect(Object* o) : ParentVect(){obj_ = o; label_ = NULL; map_ = NULL; nexport_ = 0; MUTCONSTRUCT(0)}
+IvocVect::IvocVect(int l, Object* o) : ParentVect(l){obj_ = o; label_ = NULL; map_ = NULL; nexport_ = 0; MUTCONSTRUCT(0)}
+IvocVect::IvocVect(int l, double fill_value, Object* o) : ParentVect(l, fill_value){obj_ = o; label_ = NULL; map_ = NULL; nexport_ = 0; MUTCONSTRUCT(0)}
+IvocVect::IvocVect(IvocVect& v, Object* o) : ParentVect(v) {obj_ = o; label_ = NULL; map_ = NULL; nexport_ = 0; MUTCONSTRUCT(0)}
 
 IvocVect::~IvocVect(){
 	MUTDESTRUCT
@@ -149,6 +292,7 @@ IvocVect::~IvocVect(){
 		delete [] label_;
 	}
 	notify_freed_val_array(vec(), capacity());
+	unmap(false);
 }
 
 void IvocVect::label(const char* label) {
@@ -203,7 +347,9 @@ IvocVect* IvocVect::subvec(int start, int end) {
 void IvocVect::resize(int newlen) { // all that for this
 	long oldcap = capacity();
 	if (newlen > space) {
+		realloc_check();
 		notify_freed_val_array(vec(), capacity());
+		unmap(true);
 	}
 	ParentVect::resize(newlen);
 	for (;oldcap < newlen; ++oldcap) {
@@ -608,6 +754,30 @@ static double v_vwrite(void* v) {
 }
 
 
+// v.mmap("file" [, writable [, vwrite_header]])
+// The Vector's data becomes the file of doubles, written by Vector.fwrite
+// or, with vwrite_header, Vector.vwrite(f) or vwrite(f, 4). Suitable for
+// Vector.play of a stimulus too large to read into memory, or for a
+// record Vector: a record that stays within the mapped size, e.g. a
+// writable file created with the final length, writes to the file.
+// Returns the number of elements.
+static double v_mmap(void* v) {
+	Vect* x = (Vect*)v;
+	bool writable = ifarg(2) && *getarg(2) != 0.;
+	bool header = ifarg(3) && *getarg(3) != 0.;
+	return double(x->map_file(gargstr(1), writable, header));
+}
+
+// v.munmap([keep]) releases the file. With keep, the data is copied into
+// ordinary memory, otherwise the Vector is left with size 0.
+// Returns 1 if the Vector was mapped.
+static double v_munmap(void* v) {
+	Vect* x = (Vect*)v;
+	bool mapped = x->mapped();
+	x->unmap(ifarg(1) && *getarg(1) != 0.);
+	return double(mapped);
+}
+
 static double v_vread(void* v) {
 	Vect* vp = (Vect*)v;
 	void* s = (void*)(vp->vec());
@@ -1082,12 +1252,8 @@ static Object** v_histogram(void* v) {
 	y->fill(0.);
 //	for (i=0; i< n; i++) y->elem(i) = h.inBucket(i);
 
-	for (i=0; i < x->capacity(); ++i) {
-		int ind = int(floor((x->elem(i) - low)/width)) + 1;
-		if (ind >= 0 && ind < y->capacity()) {
-			y->elem(ind) += 1.0;
-		}
-	}
+	vec_op(VJ_HIST, x->capacity(), x->vec(), NULL, low, width, 0.,
+		y->vec(), n);
 	return y->temp_objvar();
 }
 
@@ -1268,17 +1434,148 @@ int IvocVect::buffer_size() {
 	return space;
 }
 
+void IvocVect::realloc_check() {
+	if (nexport_) {
+		hoc_execerror("cannot reallocate a Vector while a Python buffer",
+			"(e.g. a numpy array) shares its data");
+	}
+}
+
 void IvocVect::buffer_size(int n) {
+	realloc_check();
 	double* y = new double[n];
-	if (len > n) {
-		len = n;
-	}
-	for (int i=0; i < len; ++i) {
+	int newlen = (len > n) ? n : len;
+	for (int i=0; i < newlen; ++i) {
 		y[i] = s[i];
 	}
+	unmap(false); // if mapped, the data is already in y; sets len = 0
+	delete [] s;
+	len = newlen;
 	space = n;
+	s = y;
+}
+
+// The mapping is MAP_SHARED when writable, so element changes go to the
+// file. Otherwise MAP_PRIVATE, so changes stay in memory and the file is
+// never modified. Pages are read on first touch, so a huge file costs
+// only the address space until it is used.
+int IvocVect::map_file(const char* fname, bool writable, bool header) {
+#if HAVE_MMAP
+	realloc_check();
+	int fd = open(fname, writable ? O_RDWR : O_RDONLY);
+	if (fd < 0) {
+		hoc_execerror("Vector.mmap could not open", fname);
+	}
+	struct stat st;
+	size_t off = 0;
+	long n;
+	if (fstat(fd, &st) != 0) {
+		close(fd);
+		hoc_execerror("Vector.mmap could not stat", fname);
+	}
+	if (header) { // as written by Vector.vwrite(f) or vwrite(f, 4)
+		int h[2];
+		off = sizeof(h);
+		if (read(fd, h, sizeof(h)) != sizeof(h) || h[1] != 4) {
+			close(fd);
+hoc_execerror(fname, "is not a Vector.vwrite file of doubles in native byte order");
+		}
+		n = h[0];
+		if ((long)off + n * (long)sizeof(double) > (long)st.st_size) {
+			close(fd);
+			hoc_execerror(fname, "is shorter than its vwrite header says");
+		}
+	}else{
+		n = (long)st.st_size / (long)sizeof(double);
+	}
+	if (n > dmaxint_) {
+		close(fd);
+		hoc_execerror(fname, "has too many elements for a Vector");
+	}
+	void* p = NULL;
+	if (n > 0) {
+		p = ::mmap(0, st.st_size, PROT_READ | PROT_WRITE,
+			writable ? MAP_SHARED : MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	if (p == MAP_FAILED) {
+		hoc_execerror("Vector.mmap failed for", fname);
+	}
+	notify_freed_val_array(vec(), capacity());
+	unmap(false);
 	delete [] s;
+	if (p) {
+		map_ = p;
+		maplen_ = st.st_size;
+		map_shared_ = writable;
+		map_lo_ = map_hi_ = 0;
+		map_dropped_ = 0;
+		s = (double*)((char*)p + off);
+	}else{
+		s = new double[1];
+	}
+	len = space = int(n);
+	return len;
+#else
+	hoc_execerror("Vector.mmap", "is not available on this platform");
+	return 0;
+#endif
+}
+
+// Vector.play through a mapped file. When the element being played leaves
+// the current window, ask the kernel to read ahead the next window in the
+// background and, for a shared mapping, drop the pages more than a window
+// behind, so resident memory stays about two windows however long the
+// file. Pages of a private mapping are not dropped since that would
+// discard element changes; unchanged ones are reclaimable anyway. A jump
+// backwards, e.g. after SaveState.restore, just faults the pages back in.
+#define MAP_WINDOW (1 << 20) // elements
+
+void IvocVect::map_advise(int i) {
+#if HAVE_MMAP
+	size_t pg = (size_t)sysconf(_SC_PAGESIZE);
+	char* base = (char*)map_;
+	size_t off = ((char*)(s + i) - base) / pg * pg;
+	int n = (len - i < MAP_WINDOW) ? len - i : MAP_WINDOW;
+	if (n > 0) {
+		size_t end = (char*)(s + i + n) - base;
+		madvise(base + off, end - off, MADV_WILLNEED);
+	}
+	if (i < map_lo_) {
+		map_dropped_ = 0;
+	}
+	if (map_shared_ && i > MAP_WINDOW) {
+		size_t drop = ((char*)(s + i - MAP_WINDOW) - base) / pg * pg;
+		if (drop > map_dropped_) {
+			madvise(base + map_dropped_, drop - map_dropped_, MADV_DONTNEED);
+			map_dropped_ = drop;
+		}
+	}
+	map_lo_ = i;
+	map_hi_ = i + MAP_WINDOW/2;
+#endif
+}
+
+// Release the mapped file. If keep, the data is first copied into
+// ordinary memory, otherwise the Vector is left empty.
+void IvocVect::unmap(bool keep) {
+#if HAVE_MMAP
+	if (!map_) {
+		return;
+	}
+	realloc_check();
+	double* y = new double[keep ? (space ? space : 1) : 1];
+	if (keep) {
+		for (int i=0; i < len; ++i) {
+			y[i] = s[i];
+		}
+	}else{
+		len = space = 0;
+	}
+	::munmap(map_, maplen_);
+	map_ = NULL;
 	s = y;
+#endif
 }
 
 static Object** v_resize(void* v) {
@@ -1610,6 +1907,40 @@ thet = (xd->elem(id) - xs->elem(is-1))/(xs->elem(is) - xs->elem(is-1));
 	return yd->temp_objvar();
 }
 
+// apply, reduce, and the where family accept an expression of $1 in place
+// of a function name or comparator, e.g. v.apply("exp(-$1/tau)") or
+// v.indvwhere("$1 > 2 && $1 < 5")
+static VecExpr* vecexpr_;
+
+static VecExpr* vec_expr(const char* s) {
+	if (!vecexpr_) {
+		vecexpr_ = new VecExpr();
+	}
+	vecexpr_->compile(s);
+	return vecexpr_;
+}
+
+#define WHERE_BLOCK 1024
+
+// append to y the elements (or indices if ind) of x where expr is nonzero
+static void where_expr(ParentVect* x, const char* expr, Vect* y, bool ind) {
+	VecExpr* ve = vec_expr(expr);
+	double buf[WHERE_BLOCK];
+	int n = x->capacity();
+	int m = 0;
+	y->resize(0);
+	for (int i0 = 0; i0 < n; i0 += WHERE_BLOCK) {
+		int nb = (n - i0 < WHERE_BLOCK) ? n - i0 : WHERE_BLOCK;
+		ve->eval(x->vec() + i0, buf, nb);
+		for (int k = 0; k < nb; ++k) {
+			if (buf[k] != 0.) {
+				y->resize_chunk(++m);
+				y->elem(m-1) = ind ? double(i0 + k) : x->elem(i0 + k);
+			}
+		}
+	}
+}
+
 static int possible_srcvec(ParentVect*& src, Vect* dest, int& flag) {
 	if (ifarg(1) && hoc_is_object_arg(1)) {
 	 	src = vector_arg(1);
@@ -1634,6 +1965,13 @@ static Object** v_where(void* v) {
 	int i;
 
 	char* op = gargstr(iarg++);
+	if (!ifarg(iarg)) {
+		where_expr(x, op, y, false);
+		if (flag) {
+			delete x;
+		}
+		return y->temp_objvar();
+	}
 	double value = *getarg(iarg++);
 	double value2;
 	
@@ -1730,11 +2068,24 @@ static double v_indwhere(void* v) {
   double value,value2;
 
     op = gargstr(1);
+  int n = x->capacity();
+  if (!ifarg(2)) {
+	VecExpr* ve = vec_expr(op);
+	double buf[WHERE_BLOCK];
+	for (int i0 = 0; i0 < n; i0 += WHERE_BLOCK) {
+		int nb = (n - i0 < WHERE_BLOCK) ? n - i0 : WHERE_BLOCK;
+		ve->eval(x->vec() + i0, buf, nb);
+		for (i = 0; i < nb; ++i) {
+			if (buf[i] != 0.) {
+				return i0 + i;
+			}
+		}
+	}
+	return -1.;
+  }
     value = *getarg(2);
     iarg = 3;
 
-  int n = x->capacity();
-
 
 	if (!strcmp(op,"==")) {
 	  for (i=0; i<n; i++) {
@@ -1817,6 +2168,13 @@ static Object** v_indvwhere(void* v) {
 
 	iarg = possible_srcvec(x, y, flag);
     op = gargstr(iarg++);
+    if (!ifarg(iarg)) {
+	where_expr(x, op, y, true);
+	if (flag) {
+		delete x;
+	}
+	return y->temp_objvar();
+    }
     value = *getarg(iarg++);
     y->resize(0);
 
@@ -2007,6 +2365,11 @@ static Object** v_apply(void* v)
     start = int(chkarg(2,0,top));
     end = int(chkarg(3,start,top));
   }
+  if (VecExpr::is_expression(func)) {
+	double* px = x->vec() + start;
+	vec_expr(func)->eval(px, px, end - start + 1);
+	return x->temp_objvar();
+  }
   Symbol* s = hoc_lookup(func);
   ob = hoc_thisobject;
   if (!s) {
@@ -2016,6 +2379,13 @@ static Object** v_apply(void* v)
 	  	hoc_execerror(func, " is undefined");
 	}
   }
+  if (s->type == BLTIN) { // sin, exp, etc. need no interpreter frame
+	double (*f)(double) = (double (*)(double))s->u.ptr;
+	for (int i=start; i<=end; i++) {
+		x->elem(i) = (*f)(x->elem(i));
+	}
+	return x->temp_objvar();
+  }
   for (int i=start; i<=end; i++) {
     hoc_pushx(x->elem(i));
     x->elem(i) = hoc_call_objfunc(s, 1, ob);
@@ -2036,10 +2406,29 @@ static double v_reduce(void* v)
   }
   char* func = gargstr(1);
   if (ifarg(2)) base = *getarg(2);
+  if (VecExpr::is_expression(func)) {
+	VecExpr* ve = vec_expr(func);
+	double buf[WHERE_BLOCK];
+	for (int i0 = start; i0 <= end; i0 += WHERE_BLOCK) {
+		int nb = (end + 1 - i0 < WHERE_BLOCK) ? end + 1 - i0 : WHERE_BLOCK;
+		ve->eval(x->vec() + i0, buf, nb);
+		for (int k = 0; k < nb; ++k) {
+			base += buf[k];
+		}
+	}
+	return base;
+  }
   Symbol* s = hoc_lookup(func);
   if (!s) {
   	hoc_execerror(func, " is undefined");
   }
+  if (s->type == BLTIN) {
+	double (*f)(double) = (double (*)(double))s->u.ptr;
+	for (int i=start; i<=end; i++) {
+		base += (*f)(x->elem(i));
+	}
+	return base;
+  }
   for (int i=start; i<=end; i++) {
     hoc_pushx(x->elem(i));
     base += hoc_call_func(s, 1);
@@ -2107,9 +2496,9 @@ static double v_sum(void* v)
   if (ifarg(1)) {
     int start = int(chkarg(1,0,x_max));
     int end = int(chkarg(2,0,x_max));
-    return (x->subvec(start,end))->sum();
+    return vec_op(VJ_SUM, end-start+1, x->vec()+start);
   } else {
-    return x->sum();
+    return vec_op(VJ_SUM, x->capacity(), x->vec());
   }
 }
 
@@ -2120,9 +2509,9 @@ static double v_sumsq(void* v)
   if (ifarg(1)) {
     int start = int(chkarg(1,0,x_max));
     int end = int(chkarg(2,0,x_max));
-    return (x->subvec(start,end))->sumsq();
+    return vec_op(VJ_SUMSQ, end-start+1, x->vec()+start);
   } else {
-    return x->sumsq();
+    return vec_op(VJ_SUMSQ, x->capacity(), x->vec());
   }
 }
 
@@ -2136,12 +2525,12 @@ static double v_mean(void* v)
     if (end - start < 1) {
 	hoc_execerror("end - start", "must be > 0");
     }
-    return (x->subvec(start,end))->mean();
+    return vec_op(VJ_SUM, end-start+1, x->vec()+start)/(end-start+1);
   } else {
     if (x->capacity() < 1) {
 	hoc_execerror("Vector", "must have size > 0");
     }
-    return x->mean();
+    return vec_op(VJ_SUM, x->capacity(), x->vec())/x->capacity();
   }
 }
 
@@ -2155,12 +2544,12 @@ static double v_var(void* v)
     if (end - start < 1) {
 	hoc_execerror("end - start", "must be > 1");
     }
-    return (x->subvec(start,end))->var();
+    return vec_var(x, start, end);
   } else {
     if (x->capacity() < 2) {
 	hoc_execerror("Vector", "must have size > 1");
     }
-    return x->var();
+    return vec_var(x, 0, x_max);
   }
 }
 
@@ -2174,12 +2563,12 @@ static double v_stdev(void* v)
     if (end - start < 1) {
 	hoc_execerror("end - start", "must be > 1");
     }
-    return (x->subvec(start,end))->stdDev();
+    return sqrt(vec_var(x, start, end));
   } else {
     if (x->capacity() < 2) {
 	hoc_execerror("Vector", "must have size > 1");
     }
-    return x->stdDev();
+    return sqrt(vec_var(x, 0, x_max));
   }
 }
 
@@ -2193,12 +2582,12 @@ static double v_stderr(void* v)
     if (end - start < 1) {
 	hoc_execerror("end - start", "must be > 1");
     }
-    return (x->subvec(start,end))->stdDev()/hoc_Sqrt(double(end-start+1));
+    return sqrt(vec_var(x, start, end))/hoc_Sqrt(double(end-start+1));
   } else {
     if (x->capacity() < 2) {
 	hoc_execerror("Vector", "must have size > 1");
     }
-    return x->stdDev()/hoc_Sqrt((double)x_max+1.);
+    return sqrt(vec_var(x, 0, x_max))/hoc_Sqrt((double)x_max+1.);
   }
 }
 
@@ -2239,13 +2628,16 @@ static double v_dot(void* v1)
 {
   Vect* x = (Vect*)v1;
   Vect* y = vector_arg(1);
-  return (*x) * (*y);
+  if (x->capacity() != y->capacity()) {
+    hoc_execerror("Vector","Vector argument to .dot() wrong size\n");
+  }
+  return vec_op(VJ_DOT, x->capacity(), x->vec(), y->vec());
 }
 
 static double v_mag(void* v1)
 {
   Vect* x = (Vect*)v1;
-  return hoc_Sqrt(x->sumsq());
+  return hoc_Sqrt(vec_op(VJ_SUMSQ, x->capacity(), x->vec()));
 }
 
 static Object** v_from_double(void* v) {
@@ -2264,14 +2656,14 @@ static Object** v_add(void* v1)
 {
   Vect* x = (Vect*)v1;
   if (hoc_argtype(1) == NUMBER) {
-    (*x) += *getarg(1);
+    vec_op(VJ_ADDS, x->capacity(), x->vec(), NULL, *getarg(1));
   } 
   if (hoc_is_object_arg(1)) {
     Vect* y = vector_arg(1);
     if (x->capacity() != y->capacity()) {
       hoc_execerror("Vector","Vector argument to .add() wrong size\n");
     } else {
-      (*x) += (*y);
+      vec_op(VJ_ADD, x->capacity(), x->vec(), y->vec());
     }
   }
   return x->temp_objvar();
@@ -2282,14 +2674,14 @@ static Object** v_sub(void* v1)
 {
   Vect* x = (Vect*)v1;
   if (hoc_argtype(1) == NUMBER) {
-    (*x) -= *getarg(1);
+    vec_op(VJ_SUBS, x->capacity(), x->vec(), NULL, *getarg(1));
   } 
   if (hoc_is_object_arg(1)) {
     Vect* y = vector_arg(1);
     if (x->capacity() != y->capacity()) {
       hoc_execerror("Vector","Vector argument to .sub() wrong size\n");
     } else {
-    (*x) -= (*y); 
+    vec_op(VJ_SUB, x->capacity(), x->vec(), y->vec());
     }
   }
   return x->temp_objvar();
@@ -2299,14 +2691,14 @@ static Object** v_mul(void* v1)
 {
   Vect* x = (Vect*)v1;
   if (hoc_argtype(1) == NUMBER) {
-    (*x) *= *getarg(1);
+    vec_op(VJ_MULS, x->capacity(), x->vec(), NULL, *getarg(1));
   } 
   if (hoc_is_object_arg(1)) {
     Vect* y = vector_arg(1);
     if (x->capacity() != y->capacity()) {
       hoc_execerror("Vector","Vector argument to .mult() wrong size\n");
     } else {
-      x->product(*y);
+      vec_op(VJ_MUL, x->capacity(), x->vec(), y->vec());
     }
   }
   return x->temp_objvar();
@@ -2317,14 +2709,14 @@ static Object** v_div(void* v1)
 {
   Vect* x = (Vect*)v1;
   if (hoc_argtype(1) == NUMBER) {
-    (*x) /= *getarg(1);
+    vec_op(VJ_DIVS, x->capacity(), x->vec(), NULL, *getarg(1));
   } 
   if (hoc_is_object_arg(1)) {
     Vect* y = vector_arg(1);
     if (x->capacity() != y->capacity()) {
       hoc_execerror("Vector","Vector argument to .div() wrong size\n");
     } else {
-      x->quotient(*y);
+      vec_op(VJ_DIV, x->capacity(), x->vec(), y->vec());
     }
   }
   return x->temp_objvar();
@@ -2340,9 +2732,7 @@ static double v_scale(void* v1)
     double r = x->max()-x->min();
     if (r > 0) {
       sf = (b-a)/r;
-      (*x) -= x->min();
-      (*x) *= sf;
-      (*x) += a;
+      vec_op(VJ_AFFINE, x->capacity(), x->vec(), NULL, x->min(), sf, a);
     } else {
       sf = 0.;
     }
@@ -3572,6 +3962,14 @@ Object** v_from_python(void* v) {
 	return vec->temp_objvar();
 }
 
+Object** v_from_buffer(void* v) {
+	if (!nrnpy_vec_from_buffer_p_) {
+		hoc_execerror("Python not available", 0);
+	}
+	Vect* vec = (*nrnpy_vec_from_buffer_p_)(v);
+	return vec->temp_objvar();
+}
+
 Object** v_to_python(void* v) {
 	if (!nrnpy_vec_to_python_p_) {
 		hoc_execerror("Python not available", 0);
@@ -3626,6 +4024,8 @@ static Member_func v_members[] = {
 	"fread",        v_fread,
 	"vwrite",       v_vwrite,
 	"vread",        v_vread,
+	"mmap",         v_mmap,
+	"munmap",       v_munmap,
 	"printf",       v_printf,
 	"scanf",        v_scanf,
 	"scantil",        v_scantil,
@@ -3708,6 +4108,7 @@ static Member_ret_obj_func v_retobj_members[] = {
 	"ploterr",      v_ploterr,
 
 	"from_python",	v_from_python,
+	"from_buffer",	v_from_buffer,
 	"to_python",	v_to_python,
 	"as_numpy",	v_as_numpy,
 
@@ -29,6 +29,19 @@ public:
 	void buffer_size(int);
 	void label(const char*);
 
+	// Use a file of doubles as the data, see Vector.mmap. Any later
+	// growth beyond the mapped size copies the data into ordinary memory.
+	int map_file(const char* fname, bool writable, bool header);
+	void unmap(bool keep);
+	bool mapped() { return map_ != NULL; }
+	// sequential reader, e.g. Vector.play, is at element i of a mapped file
+	void map_advance(int i) {
+		if (map_ && (i < map_lo_ || i >= map_hi_)) { map_advise(i); }
+	}
+	void map_advise(int i);
+	// error if the data is shared with a Python buffer, see nexport_
+	void realloc_check();
+
 #if USE_PTHREAD
 	void mutconstruct(int mkmut) {if (!mut_) MUTCONSTRUCT(mkmut)}
 #else
@@ -40,6 +53,14 @@ public:
 	//intended as friend static Object** temp_objvar(IvocVect*);
 	Object* obj_;	// so far only needed by record and play; not reffed
 	char* label_;
+	void* map_;
+	size_t maplen_;
+	bool map_shared_;
+	int map_lo_, map_hi_;
+	size_t map_dropped_;
+	// number of Python buffers (e.g. numpy arrays) sharing the data.
+	// While nonzero the data must not be reallocated.
+	int nexport_;
 	MUTDEC
 };
 
@@ -19,6 +19,7 @@
 	OcList_reg(),
 	Vector_reg(),
 	OcPtrVector_reg(),
+	SpikeStats_reg(),
 	OcFile_reg(),
 	OcPointer_reg(),
 #ifdef USEMATRIX
@@ -45,6 +46,7 @@
 	OcList_reg,
 	Vector_reg,
 	OcPtrVector_reg,
+	SpikeStats_reg,
 	OcFile_reg,
 	OcPointer_reg,
 #ifdef USEMATRIX
@@ -33,9 +33,26 @@ static void Vect2VEC(Vect* v1, VEC& v2) {
 #endif
 }
 
-OcMatrix::OcMatrix(int type) {obj_ = NULL; type_ = type;}
+OcMatrix::OcMatrix(int type) {obj_ = NULL; type_ = type; nexport_ = 0;}
 OcMatrix::~OcMatrix() {}
 
+// for code that cannot include ocmatrix.h, e.g. the Python buffer protocol
+double* matrix_pelm(void* vm, int i, int j) {
+	return ((OcMatrix*)vm)->mep(i, j);
+}
+int matrix_nrow(void* vm) {
+	return ((OcMatrix*)vm)->nrow();
+}
+int matrix_ncol(void* vm) {
+	return ((OcMatrix*)vm)->ncol();
+}
+int matrix_type(void* vm) {
+	return ((OcMatrix*)vm)->type();
+}
+void matrix_export(void* vm, int incr) {
+	((OcMatrix*)vm)->nexport_ += incr;
+}
+
 OcMatrix* OcMatrix::instance(int nrow, int ncol, int type) {
 	switch (type) {
 	default:
@@ -111,9 +128,21 @@ int OcFullMatrix::ncol() {
 }
 
 void OcFullMatrix::resize(int i, int j) {
+	if (nexport_ && (i != nrow() || j != ncol())) {
+		hoc_execerror("cannot change the size of a Matrix while a Python buffer",
+			"(e.g. a numpy array) shares its data");
+	}
 	m_resize(m_, i, j);
 }
 
+// The Meschach functions resize their output as needed. Resize it here
+// first so a Matrix shared with a Python buffer is not reallocated.
+MAT* OcFullMatrix::out_mat(Matrix* out, int nrow, int ncol) {
+	OcFullMatrix* f = out->full();
+	f->resize(nrow, ncol);
+	return f->m_;
+}
+
 void OcFullMatrix::mulv(Vect* vin, Vect* vout) {
 	VEC v1, v2;
 	Vect2VEC(vin, v1);
@@ -122,33 +151,34 @@ void OcFullMatrix::mulv(Vect* vin, Vect* vout) {
 }
 
 void OcFullMatrix::mulm(Matrix* in, Matrix* out) {
-	m_mlt(m_, in->full()->m_, out->full()->m_);
+	m_mlt(m_, in->full()->m_, out_mat(out, nrow(), in->ncol()));
 }
 
 void OcFullMatrix::muls(double s, Matrix* out) {
-	sm_mlt(s, m_, out->full()->m_);
+	sm_mlt(s, m_, out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::add(Matrix* in, Matrix* out) {
-	m_add(m_, in->full()->m_, out->full()->m_);
+	m_add(m_, in->full()->m_, out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::copy(Matrix* out) {
-	m_copy(m_, out->full()->m_);
+	m_copy(m_, out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::bcopy(Matrix* out, int i0, int j0, int n0, int m0, int i1, int j1) {
-	m_move(m_, i0, j0, n0, m0, out->full()->m_, i1, j1);
+	m_move(m_, i0, j0, n0, m0, out_mat(out, max(out->nrow(), i1 + n0),
+		max(out->ncol(), j1 + m0)), i1, j1);
 }
 
 void OcFullMatrix::transpose(Matrix* out) {
-	m_transp(m_, out->full()->m_);
+	m_transp(m_, out_mat(out, ncol(), nrow()));
 }
 
 void OcFullMatrix::symmeigen(Matrix* mout, Vect* vout) {
 	VEC v1;
 	Vect2VEC(vout, v1);
-	symmeig(m_, mout->full()->m_, &v1);
+	symmeig(m_, out_mat(mout, nrow(), nrow()), &v1);
 }
 
 void OcFullMatrix::svd1(Matrix* u, Matrix* v, Vect* d) {
@@ -265,15 +295,15 @@ void OcFullMatrix::ident() {
 }
 
 void OcFullMatrix::exp(Matrix* out) {
-	m_exp(m_, 0., out->full()->m_);
+	m_exp(m_, 0., out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::pow(int i, Matrix* out) {
-	m_pow(m_, i, out->full()->m_);
+	m_pow(m_, i, out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::inverse(Matrix* out) {
-	m_inverse(m_, out->full()->m_);
+	m_inverse(m_, out_mat(out, nrow(), ncol()));
 }
 
 void OcFullMatrix::solv(Vect* in, Vect* out, bool use_lu) {
@@ -65,16 +65,23 @@ public:
 
 	void unimp();
 	Object** temp_objvar();
+	int type() { return type_; }
 protected:
 	OcMatrix(int type);
 public:
 	Object* obj_;
+	int nexport_;	// Python buffers sharing the data, see resize
 private:
 	int type_;
 };
 
 extern "C" {
 	extern Matrix* matrix_arg(int);
+	extern double* matrix_pelm(void*, int i, int j);
+	extern int matrix_nrow(void*);
+	extern int matrix_ncol(void*);
+	extern int matrix_type(void*);	// FULL 1, SPARSE 2, BAND 3
+	extern void matrix_export(void*, int incr);
 }
 
 class OcFullMatrix : public OcMatrix {	// type 1
@@ -114,6 +121,7 @@ public:
 	virtual void svd1(Matrix* u, Matrix* v, Vect* d);
 	virtual double det(int* exponent);
 private:
+	static MAT* out_mat(Matrix* out, int nrow, int ncol);
 	MAT* m_;
 	MAT* lu_factor_;
 	PERM* lu_pivot_;
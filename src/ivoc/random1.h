@@ -10,9 +10,15 @@ class Rand {
 public:
   Rand(unsigned long seed = 0, int size = 55, Object* obj = NULL);
   ~Rand();
+  // distributions that r_fill can compute from Random123 counter blocks
+  enum { RD_OTHER, RD_UNIFORM, RD_DISCUNIF, RD_NORMAL, RD_LOGNORMAL, RD_NEGEXP };
+  // Replaces (and deletes) rand. Always use this rather than assigning
+  // rand so that dist_ says what kind of Random rand is.
+  void distribution(Random*, int dist = RD_OTHER);
   RNG *gen;
   Random *rand;
   int type_; // can do special things with some kinds of RNG
+  int dist_; // kind of rand, set only by distribution, see r_fill
   // double* looks like random variable that gets changed on every fadvance
   Object* obj_;
 }; 
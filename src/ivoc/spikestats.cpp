@@ -0,0 +1,554 @@
+#include <../../nrnconf.h>
+/*
+ statistics of the spikes recorded by ParallelContext.spike_record
+	ss = new SpikeStats(tvec, idvec)
+	ss.nspike()
+	ss.ngid()
+	ss.gids(vec)
+	ss.train(vec, gid)
+	ss.count(vec)
+	ss.rate(vec, tstart, tstop)
+	ss.isicv(vec)
+	ss.isihist(vec, binwidth, maxisi)
+	ss.psth(vec, binwidth, tstart, tstop)
+	ss.xcorr(vec, gid1, gid2, binwidth, maxlag)
+ The constructor groups the spikes by gid, in increasing gid order and
+ increasing time within a gid, so every statistic is a pass over
+ contiguous spike trains instead of a hoc loop extracting per gid
+ Vectors. The per gid results (count, rate, isicv) are in gids(vec) order.
+ Long passes are split among the threads started by
+ ParallelContext.nthread(n, 1).
+*/
+#include <math.h>
+#include <algorithm>
+#include "classreg.h"
+#include "oc2iv.h"
+#include "ivocvect.h"
+
+extern "C" {
+extern int (*nrn_vec_multithread_p_)(void (*job)(int, int));
+}
+
+#define SS_MT_MIN 100000
+#define SS_MAXBIN 100000000
+
+struct SpikeRec {
+	double id, t;
+};
+
+static bool spikerec_lt(const SpikeRec& a, const SpikeRec& b) {
+	return a.id < b.id || (a.id == b.id && a.t < b.t);
+}
+
+class SpikeStats {
+public:
+	SpikeStats(const double* t, const double* id, int n);
+	virtual ~SpikeStats();
+	int index(double gid); // into gid_, -1 if no spikes
+	int nspike() { return first_[ngid_]; }
+	int count(int i) { return first_[i + 1] - first_[i]; }
+	double* train(int i) { return t_ + first_[i]; }
+private:
+	bool count_sort(const double* t, const double* id, int n);
+	void general_sort(const double* t, const double* id, int n);
+public:
+	int ngid_;
+	double* gid_; // distinct gids ascending
+	int* first_; // train i is t_[first_[i]] to t_[first_[i+1]-1]
+	double* t_;
+};
+
+// Parallel jobs. The threads split the range of gids (or spikes, or
+// sort chunks) evenly and histograms are accumulated into per thread
+// rows of part which are summed afterwards.
+
+enum { SS_SORT_TRAINS, SS_SORT_CHUNKS, SS_RATE, SS_ISICV, SS_ISIHIST,
+	SS_PSTH, SS_XCORR };
+
+static struct SSJob {
+	int op;
+	int nth;
+	SpikeStats* ss;
+	SpikeRec* rec;
+	int n;
+	double a, b;
+	int nbin;
+	double* y;
+	double* part;
+	const int* ia;
+	const int* ib;
+	int nb;
+} ssjob_;
+
+static void ss_trains(int i0, int i1) {
+	SSJob& j = ssjob_;
+	SpikeStats* ss = j.ss;
+	for (int i = i0; i < i1; ++i) {
+		double* t = ss->train(i);
+		int m = ss->count(i);
+		switch (j.op) {
+		case SS_SORT_TRAINS: {
+			for (int k = 1; k < m; ++k) {
+				if (t[k] < t[k - 1]) {
+					std::sort(t, t + m);
+					break;
+				}
+			}
+			}break;
+		case SS_RATE: {
+			// a, b is the window [tstart, tstop)
+			double* lo = std::lower_bound(t, t + m, j.a);
+			double* hi = std::lower_bound(t, t + m, j.b);
+			j.y[i] = double(hi - lo) * 1000. / (j.b - j.a);
+			}break;
+		case SS_ISICV: {
+			double cv = 0.;
+			if (m > 2) {
+				double s = 0., ss2 = 0., mean;
+				for (int k = 1; k < m; ++k) {
+					s += t[k] - t[k - 1];
+				}
+				mean = s/(m - 1);
+				for (int k = 1; k < m; ++k) {
+					double d = t[k] - t[k - 1] - mean;
+					ss2 += d*d;
+				}
+				if (mean > 0.) {
+					cv = sqrt(ss2/(m - 2))/mean;
+				}
+			}
+			j.y[i] = cv;
+			}break;
+		}
+	}
+}
+
+static void ss_job(int it, int nth) {
+	SSJob& j = ssjob_;
+	SpikeStats* ss = j.ss;
+	double* h = j.part + it * j.nbin;
+	switch (j.op) {
+	case SS_SORT_TRAINS:
+	case SS_RATE:
+	case SS_ISICV:
+		ss_trains(int((long)ss->ngid_ * it / nth),
+			int((long)ss->ngid_ * (it + 1) / nth));
+		break;
+	case SS_SORT_CHUNKS: {
+		int i0 = int((long)j.n * it / nth);
+		int i1 = int((long)j.n * (it + 1) / nth);
+		std::sort(j.rec + i0, j.rec + i1, spikerec_lt);
+		}break;
+	case SS_ISIHIST: {
+		// a is the bin width
+		int i0 = int((long)ss->ngid_ * it / nth);
+		int i1 = int((long)ss->ngid_ * (it + 1) / nth);
+		for (int i = i0; i < i1; ++i) {
+			double* t = ss->train(i);
+			int m = ss->count(i);
+			for (int k = 1; k < m; ++k) {
+				double x = floor((t[k] - t[k - 1])/j.a);
+				if (x < j.nbin) {
+					h[int(x)] += 1.;
+				}
+			}
+		}
+		}break;
+	case SS_PSTH: {
+		// a is the bin width, b is tstart
+		int i0 = int((long)ss->nspike() * it / nth);
+		int i1 = int((long)ss->nspike() * (it + 1) / nth);
+		double* t = ss->t_;
+		for (int k = i0; k < i1; ++k) {
+			double x = floor((t[k] - j.b)/j.a);
+			if (x >= 0. && x < j.nbin) {
+				h[int(x)] += 1.;
+			}
+		}
+		}break;
+	case SS_XCORR: {
+		// a is the bin width, b is maxlag. Lags tb - ta in [-maxlag, maxlag)
+		int i0 = int((long)j.n * it / nth);
+		int i1 = int((long)j.n * (it + 1) / nth);
+		for (int p = i0; p < i1; ++p) {
+			double* ta = ss->train(j.ia[p]);
+			int na = ss->count(j.ia[p]);
+			for (int q = 0; q < j.nb; ++q) {
+				if (j.ib[q] == j.ia[p]) {
+					continue;
+				}
+				double* tb = ss->train(j.ib[q]);
+				int nb = ss->count(j.ib[q]);
+				int lo = 0;
+				for (int k = 0; k < na; ++k) {
+					while (lo < nb && tb[lo] < ta[k] - j.b) {
+						++lo;
+					}
+					for (int l = lo; l < nb && tb[l] < ta[k] + j.b; ++l) {
+						double x = floor((tb[l] - ta[k] + j.b)/j.a);
+						if (x >= 0. && x < j.nbin) {
+							h[int(x)] += 1.;
+						}
+					}
+				}
+			}
+		}
+		}break;
+	}
+}
+
+// number of threads worth using for work items
+static int ss_nthread(long work) {
+	int nth = 1;
+	if (work >= SS_MT_MIN && nrn_vec_multithread_p_) {
+		nth = (*nrn_vec_multithread_p_)(NULL);
+		if (nth < 1) {
+			nth = 1;
+		}
+	}
+	return nth;
+}
+
+static void ss_run(int op, SpikeStats* ss, int nth) {
+	ssjob_.op = op;
+	ssjob_.ss = ss;
+	ssjob_.nth = nth;
+	if (nth > 1) {
+		(*nrn_vec_multithread_p_)(ss_job);
+	}else{
+		ss_job(0, 1);
+	}
+}
+
+// histogram job with nbin bins. The result is in y.
+static void ss_hist(int op, SpikeStats* ss, long work, int nbin, double* y) {
+	int nth = ss_nthread(work);
+	double* part = new double[nth * nbin];
+	for (int i = 0; i < nth * nbin; ++i) {
+		part[i] = 0.;
+	}
+	ssjob_.nbin = nbin;
+	ssjob_.part = part;
+	ss_run(op, ss, nth);
+	for (int i = 0; i < nbin; ++i) {
+		double s = 0.;
+		for (int it = 0; it < nth; ++it) {
+			s += part[it * nbin + i];
+		}
+		y[i] = s;
+	}
+	delete [] part;
+	ssjob_.part = NULL;
+}
+
+SpikeStats::SpikeStats(const double* t, const double* id, int n) {
+	ngid_ = 0;
+	gid_ = NULL;
+	first_ = NULL;
+	t_ = new double[n];
+	if (!count_sort(t, id, n)) {
+		general_sort(t, id, n);
+	}
+}
+
+SpikeStats::~SpikeStats() {
+	delete [] gid_;
+	delete [] first_;
+	delete [] t_;
+}
+
+// Usual case: integer gids in a range not much larger than the number of
+// spikes. One counting pass groups the trains. A train is already sorted
+// when tvec is in time order, as it is for spike_record on one rank.
+bool SpikeStats::count_sort(const double* t, const double* id, int n) {
+	int i;
+	if (n == 0) {
+		first_ = new int[1];
+		first_[0] = 0;
+		return true;
+	}
+	double idmin = id[0], idmax = id[0];
+	for (i = 0; i < n; ++i) {
+		if (id[i] != floor(id[i])) {
+			return false;
+		}
+		if (id[i] < idmin) { idmin = id[i]; }
+		if (id[i] > idmax) { idmax = id[i]; }
+	}
+	if (idmax - idmin > 4. * n + 65536.) {
+		return false;
+	}
+	int range = int(idmax - idmin) + 1;
+	int* cnt = new int[range + 1];
+	for (i = 0; i <= range; ++i) {
+		cnt[i] = 0;
+	}
+	for (i = 0; i < n; ++i) {
+		++cnt[int(id[i] - idmin) + 1];
+	}
+	for (i = 0; i < range; ++i) {
+		if (cnt[i + 1]) {
+			++ngid_;
+		}
+		cnt[i + 1] += cnt[i];
+	}
+	gid_ = new double[ngid_];
+	first_ = new int[ngid_ + 1];
+	int ig = 0;
+	for (i = 0; i < range; ++i) {
+		if (cnt[i + 1] > cnt[i]) {
+			gid_[ig] = idmin + i;
+			first_[ig++] = cnt[i];
+		}
+	}
+	first_[ngid_] = n;
+	// cnt[i] is now the next free slot of id idmin + i
+	for (i = 0; i < n; ++i) {
+		t_[cnt[int(id[i] - idmin)]++] = t[i];
+	}
+	delete [] cnt;
+	ss_run(SS_SORT_TRAINS, this, ss_nthread(n));
+	return true;
+}
+
+void SpikeStats::general_sort(const double* t, const double* id, int n) {
+	int i;
+	SpikeRec* rec = new SpikeRec[n];
+	for (i = 0; i < n; ++i) {
+		rec[i].id = id[i];
+		rec[i].t = t[i];
+	}
+	int nth = ss_nthread(n);
+	ssjob_.rec = rec;
+	ssjob_.n = n;
+	ss_run(SS_SORT_CHUNKS, this, nth);
+	// merge the sorted chunks pairwise
+	for (int w = 1; w < nth; w *= 2) {
+		for (int c = 0; c + w < nth; c += 2*w) {
+			int i0 = int((long)n * c / nth);
+			int im = int((long)n * (c + w) / nth);
+			int e = (c + 2*w < nth) ? c + 2*w : nth;
+			int i1 = int((long)n * e / nth);
+			std::inplace_merge(rec + i0, rec + im, rec + i1, spikerec_lt);
+		}
+	}
+	for (i = 0; i < n; ++i) {
+		if (i == 0 || rec[i].id != rec[i - 1].id) {
+			++ngid_;
+		}
+	}
+	gid_ = new double[ngid_];
+	first_ = new int[ngid_ + 1];
+	ngid_ = 0;
+	for (i = 0; i < n; ++i) {
+		if (i == 0 || rec[i].id != rec[i - 1].id) {
+			gid_[ngid_] = rec[i].id;
+			first_[ngid_++] = i;
+		}
+		t_[i] = rec[i].t;
+	}
+	first_[ngid_] = n;
+	delete [] rec;
+}
+
+int SpikeStats::index(double gid) {
+	double* p = std::lower_bound(gid_, gid_ + ngid_, gid);
+	if (p < gid_ + ngid_ && *p == gid) {
+		return int(p - gid_);
+	}
+	return -1;
+}
+
+// gid indices of a number or Vector argument. Gids without spikes are
+// skipped.
+static int* gid_indices(SpikeStats* ss, int iarg, int* n) {
+	int* ix;
+	*n = 0;
+	if (hoc_is_object_arg(iarg)) {
+		Vect* v = vector_arg(iarg);
+		int m = vector_capacity(v);
+		double* px = vector_vec(v);
+		ix = new int[m + 1];
+		for (int i = 0; i < m; ++i) {
+			int k = ss->index(px[i]);
+			if (k >= 0) {
+				ix[(*n)++] = k;
+			}
+		}
+	}else{
+		ix = new int[1];
+		int k = ss->index(*getarg(iarg));
+		if (k >= 0) {
+			ix[(*n)++] = k;
+		}
+	}
+	return ix;
+}
+
+static Vect* resized_arg(int iarg, int n) {
+	Vect* y = vector_arg(iarg);
+	y->resize(n);
+	return y;
+}
+
+static double nspike(void* v) {
+	return double(((SpikeStats*)v)->nspike());
+}
+
+static double ngid(void* v) {
+	return double(((SpikeStats*)v)->ngid_);
+}
+
+static Object** gids(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	Vect* y = resized_arg(1, ss->ngid_);
+	double* py = vector_vec(y);
+	for (int i = 0; i < ss->ngid_; ++i) {
+		py[i] = ss->gid_[i];
+	}
+	return y->temp_objvar();
+}
+
+static Object** train(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	int i = ss->index(*getarg(2));
+	int m = (i < 0) ? 0 : ss->count(i);
+	Vect* y = resized_arg(1, m);
+	double* py = vector_vec(y);
+	for (int k = 0; k < m; ++k) {
+		py[k] = ss->train(i)[k];
+	}
+	return y->temp_objvar();
+}
+
+static Object** count(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	Vect* y = resized_arg(1, ss->ngid_);
+	double* py = vector_vec(y);
+	for (int i = 0; i < ss->ngid_; ++i) {
+		py[i] = double(ss->count(i));
+	}
+	return y->temp_objvar();
+}
+
+static Object** rate(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	double tstart = *getarg(2);
+	double tstop = *getarg(3);
+	if (tstop <= tstart) {
+		hoc_execerror("SpikeStats.rate", "tstop must be greater than tstart");
+	}
+	Vect* y = resized_arg(1, ss->ngid_);
+	ssjob_.y = vector_vec(y);
+	ssjob_.a = tstart;
+	ssjob_.b = tstop;
+	ss_run(SS_RATE, ss, ss_nthread(ss->ngid_));
+	return y->temp_objvar();
+}
+
+static Object** isicv(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	Vect* y = resized_arg(1, ss->ngid_);
+	ssjob_.y = vector_vec(y);
+	ss_run(SS_ISICV, ss, ss_nthread(ss->nspike()));
+	return y->temp_objvar();
+}
+
+// number of bins of width covering range
+static int ss_nbin(const char* name, double range, double width) {
+	double n = ceil(range/width);
+	if (n > SS_MAXBIN) {
+		hoc_execerror(name, "too many bins, the bin width is too small");
+	}
+	return int(n);
+}
+
+static Object** isihist(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	double width = chkarg(2, 1e-9, 1e9);
+	double maxisi = chkarg(3, width, 1e9);
+	int nbin = ss_nbin("SpikeStats.isihist", maxisi, width);
+	Vect* y = resized_arg(1, nbin);
+	ssjob_.a = width;
+	ss_hist(SS_ISIHIST, ss, ss->nspike(), nbin, vector_vec(y));
+	return y->temp_objvar();
+}
+
+static Object** psth(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	double width = chkarg(2, 1e-9, 1e9);
+	double tstart = *getarg(3);
+	double tstop = *getarg(4);
+	if (tstop <= tstart) {
+		hoc_execerror("SpikeStats.psth", "tstop must be greater than tstart");
+	}
+	int nbin = ss_nbin("SpikeStats.psth", tstop - tstart, width);
+	Vect* y = resized_arg(1, nbin);
+	ssjob_.a = width;
+	ssjob_.b = tstart;
+	ss_hist(SS_PSTH, ss, ss->nspike(), nbin, vector_vec(y));
+	return y->temp_objvar();
+}
+
+// Sum over pairs (a, b), a from gid1, b from gid2, a != b, of the counts of
+// tb - ta in bins of width binwidth from -maxlag to maxlag.
+static Object** xcorr(void* v) {
+	SpikeStats* ss = (SpikeStats*)v;
+	double width = chkarg(4, 1e-9, 1e9);
+	double maxlag = chkarg(5, width/2., 1e9);
+	int nbin = ss_nbin("SpikeStats.xcorr", 2.*maxlag, width);
+	int na, nb;
+	int* ia = gid_indices(ss, 2, &na);
+	int* ib = gid_indices(ss, 3, &nb);
+	long work = 0;
+	for (int i = 0; i < na; ++i) {
+		work += long(ss->count(ia[i])) * nb;
+	}
+	Vect* y = resized_arg(1, nbin);
+	ssjob_.a = width;
+	ssjob_.b = maxlag;
+	ssjob_.ia = ia;
+	ssjob_.ib = ib;
+	ssjob_.n = na;
+	ssjob_.nb = nb;
+	ss_hist(SS_XCORR, ss, work, nbin, vector_vec(y));
+	delete [] ia;
+	delete [] ib;
+	return y->temp_objvar();
+}
+
+static Member_func members[] = {
+	"nspike", nspike,
+	"ngid", ngid,
+	0, 0
+};
+
+static Member_ret_obj_func retobj_members[] = {
+	"gids", gids,
+	"train", train,
+	"count", count,
+	"rate", rate,
+	"isicv", isicv,
+	"isihist", isihist,
+	"psth", psth,
+	"xcorr", xcorr,
+	0, 0
+};
+
+static void* cons(Object*) {
+	Vect* tvec = vector_arg(1);
+	Vect* idvec = vector_arg(2);
+	int n = vector_capacity(tvec);
+	if (vector_capacity(idvec) != n) {
+		hoc_execerror("SpikeStats", "tvec and idvec must have the same size");
+	}
+	return (void*)new SpikeStats(vector_vec(tvec), vector_vec(idvec), n);
+}
+
+static void destruct(void* v) {
+	delete (SpikeStats*)v;
+}
+
+void SpikeStats_reg() {
+	class2oc("SpikeStats", cons, destruct, members, 0, retobj_members, 0);
+}
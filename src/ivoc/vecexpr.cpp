@@ -0,0 +1,354 @@
+#include <../../nrnconf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include "oc2iv.h"
+#include "parse.h"
+#include "vecexpr.h"
+
+extern "C" {
+extern double hoc_epsilon;
+extern double hoc_Pow(double, double);
+extern Symbol* hoc_lookup(const char*);
+extern double* hoc_val_pointer(const char*);
+}
+
+// The postfix program operates on a stack of blocks of VE_BLOCK values.
+// Each op is one tight loop over a block, which the compiler can
+// vectorize for the arithmetic and relational ops.
+#define VE_BLOCK 256
+
+enum { VE_X, VE_CONST, VE_ADD, VE_SUB, VE_MUL, VE_DIV, VE_POW,
+	VE_GT, VE_LT, VE_GE, VE_LE, VE_EQ, VE_NE, VE_AND, VE_OR,
+	VE_NEG, VE_NOT, VE_FUN1, VE_ATAN2 };
+
+struct VecExprOp {
+	int code;
+	bool c;	// binary op with constant right operand val
+	double val;
+	double (*f)(double);
+};
+
+bool VecExpr::is_expression(const char* s) {
+	// a function name is an identifier. Anything else is an expression.
+	if (!isalpha(*s) && *s != '_') {
+		return true;
+	}
+	for (++s; *s; ++s) {
+		if (!isalnum(*s) && *s != '_') {
+			return true;
+		}
+	}
+	return false;
+}
+
+VecExpr::VecExpr() {
+	expr_ = NULL;
+	p_ = NULL;
+	nop_ = 0;
+	maxop_ = 16;
+	op_ = new VecExprOp[maxop_];
+	stk_ = NULL;
+	stksize_ = 0;
+}
+
+VecExpr::~VecExpr() {
+	delete [] op_;
+	delete [] stk_;
+}
+
+void VecExpr::compile(const char* expr) {
+	expr_ = expr;
+	p_ = expr;
+	nop_ = 0;
+	depth_ = 0;
+	maxdepth_ = 0;
+	orexpr();
+	skipblank();
+	if (*p_) {
+		error("unexpected character");
+	}
+	if (maxdepth_ > stksize_) {
+		delete [] stk_;
+		stksize_ = maxdepth_;
+		stk_ = new double[stksize_ * VE_BLOCK];
+	}
+}
+
+void VecExpr::error(const char* s) {
+	char buf[256];
+	sprintf(buf, "%s at position %d of", s, int(p_ - expr_));
+	nop_ = 0;
+	hoc_execerror(buf, expr_);
+}
+
+void VecExpr::emit(int code, double val) {
+	if (nop_ == maxop_) {
+		VecExprOp* op = new VecExprOp[2*maxop_];
+		for (int i=0; i < nop_; ++i) {
+			op[i] = op_[i];
+		}
+		delete [] op_;
+		op_ = op;
+		maxop_ *= 2;
+	}
+	VecExprOp* last = nop_ ? op_ + nop_ - 1 : NULL;
+	if (code >= VE_ADD && code <= VE_OR) {
+		--depth_;
+		if (last && last->code == VE_CONST) {
+			// use the constant directly instead of filling a block
+			if (code == VE_DIV && last->val == 0.) {
+				error("division by zero");
+			}
+			last->code = code;
+			last->c = true;
+			return;
+		}
+	}else if (code == VE_NEG && last && last->code == VE_CONST) {
+		last->val = -last->val;
+		return;
+	}else if (code == VE_ATAN2) {
+		--depth_;
+	}else if (code == VE_X || code == VE_CONST) {
+		if (++depth_ > maxdepth_) {
+			maxdepth_ = depth_;
+		}
+	}
+	VecExprOp& op = op_[nop_++];
+	op.code = code;
+	op.c = false;
+	op.val = val;
+	op.f = NULL;
+}
+
+void VecExpr::skipblank() {
+	while (*p_ == ' ' || *p_ == '\t') {
+		++p_;
+	}
+}
+
+bool VecExpr::accept(const char* s) {
+	skipblank();
+	int n = strlen(s);
+	if (strncmp(p_, s, n) == 0) {
+		p_ += n;
+		return true;
+	}
+	return false;
+}
+
+void VecExpr::expect(const char* s) {
+	if (!accept(s)) {
+		char buf[50];
+		sprintf(buf, "expected '%s'", s);
+		error(buf);
+	}
+}
+
+// precedence as in parse.y
+void VecExpr::orexpr() {
+	andexpr();
+	while (accept("||")) {
+		andexpr();
+		emit(VE_OR);
+	}
+}
+
+void VecExpr::andexpr() {
+	relexpr();
+	while (accept("&&")) {
+		relexpr();
+		emit(VE_AND);
+	}
+}
+
+void VecExpr::relexpr() {
+	addexpr();
+	for (;;) {
+		int code;
+		if (accept("==")) { code = VE_EQ;
+		}else if (accept("!=")) { code = VE_NE;
+		}else if (accept(">=")) { code = VE_GE;
+		}else if (accept("<=")) { code = VE_LE;
+		}else if (accept(">")) { code = VE_GT;
+		}else if (accept("<")) { code = VE_LT;
+		}else{
+			return;
+		}
+		addexpr();
+		emit(code);
+	}
+}
+
+void VecExpr::addexpr() {
+	mulexpr();
+	for (;;) {
+		if (accept("+")) {
+			mulexpr();
+			emit(VE_ADD);
+		}else if (accept("-")) {
+			mulexpr();
+			emit(VE_SUB);
+		}else{
+			return;
+		}
+	}
+}
+
+void VecExpr::mulexpr() {
+	unary();
+	for (;;) {
+		if (accept("*")) {
+			unary();
+			emit(VE_MUL);
+		}else if (accept("/")) {
+			unary();
+			emit(VE_DIV);
+		}else{
+			return;
+		}
+	}
+}
+
+void VecExpr::unary() {
+	if (accept("-")) {
+		unary();
+		emit(VE_NEG);
+	}else if (accept("!")) {
+		unary();
+		emit(VE_NOT);
+	}else{
+		power();
+	}
+}
+
+void VecExpr::power() {
+	primary();
+	if (accept("^")) {
+		unary(); // right associative
+		emit(VE_POW);
+	}
+}
+
+void VecExpr::primary() {
+	skipblank();
+	if (accept("(")) {
+		orexpr();
+		expect(")");
+	}else if (accept("$1")) {
+		emit(VE_X);
+	}else if (isdigit(*p_) || *p_ == '.') {
+		char* end;
+		double d = strtod(p_, &end);
+		if (end == p_) {
+			error("bad number");
+		}
+		p_ = end;
+		emit(VE_CONST, d);
+	}else if (isalpha(*p_) || *p_ == '_') {
+		char name[100];
+		int n = 0;
+		while ((isalnum(*p_) || *p_ == '_') && n < 99) {
+			name[n++] = *p_++;
+		}
+		name[n] = '\0';
+		Symbol* s = hoc_lookup(name);
+		if (!s) {
+			error("undefined name");
+		}
+		if (accept("(")) {
+			if (s->type == BLTIN) {
+				orexpr();
+				expect(")");
+				emit(VE_FUN1);
+				op_[nop_ - 1].f = (double (*)(double))s->u.ptr;
+			}else if (strcmp(name, "atan2") == 0) {
+				orexpr();
+				expect(",");
+				orexpr();
+				expect(")");
+				emit(VE_ATAN2);
+			}else{
+				error("not a one argument built in function");
+			}
+		}else if (s->type == VAR && !ISARRAY(s)) {
+			emit(VE_CONST, *hoc_val_pointer(name));
+		}else{
+			error("not a scalar variable");
+		}
+	}else{
+		error("syntax error");
+	}
+}
+
+#define VE_UNARY(e) \
+	for (k=0; k < m; ++k) { double a = top[k]; top[k] = (e); }
+
+#define VE_BINARY(e) \
+	if (op->c) { \
+		double b = op->val; \
+		for (k=0; k < m; ++k) { double a = top[k]; top[k] = (e); } \
+	}else{ \
+		double* r = top - VE_BLOCK; \
+		for (k=0; k < m; ++k) { double a = r[k], b = top[k]; r[k] = (e); } \
+		top = r; \
+	}
+
+void VecExpr::eval(const double* x, double* y, int n) {
+	const double eps = hoc_epsilon;
+	for (int i0 = 0; i0 < n; i0 += VE_BLOCK) {
+		int k, m = (n - i0 < VE_BLOCK) ? n - i0 : VE_BLOCK;
+		const double* xb = x + i0;
+		double* top = stk_ - VE_BLOCK;
+		for (VecExprOp* op = op_; op < op_ + nop_; ++op) {
+			switch (op->code) {
+			case VE_X:
+				top += VE_BLOCK;
+				for (k=0; k < m; ++k) { top[k] = xb[k]; }
+				break;
+			case VE_CONST:
+				top += VE_BLOCK;
+				for (k=0; k < m; ++k) { top[k] = op->val; }
+				break;
+			case VE_ADD: VE_BINARY(a + b) break;
+			case VE_SUB: VE_BINARY(a - b) break;
+			case VE_MUL: VE_BINARY(a * b) break;
+			case VE_DIV: {
+				if (!op->c) {
+					int zero = 0;
+					for (k=0; k < m; ++k) { zero |= (top[k] == 0.); }
+					if (zero) {
+						hoc_execerror("division by zero", 0);
+					}
+				}
+				VE_BINARY(a / b)
+				}break;
+			case VE_POW: VE_BINARY(hoc_Pow(a, b)) break;
+			case VE_GT: VE_BINARY(double(a > b + eps)) break;
+			case VE_LT: VE_BINARY(double(a < b - eps)) break;
+			case VE_GE: VE_BINARY(double(a >= b - eps)) break;
+			case VE_LE: VE_BINARY(double(a <= b + eps)) break;
+			case VE_EQ: VE_BINARY(double(a <= b + eps && a >= b - eps)) break;
+			case VE_NE: VE_BINARY(double(a < b - eps || a > b + eps)) break;
+			case VE_AND: VE_BINARY(double(a != 0. && b != 0.)) break;
+			case VE_OR: VE_BINARY(double(a != 0. || b != 0.)) break;
+			case VE_NEG: VE_UNARY(-a) break;
+			case VE_NOT: VE_UNARY(double(a == 0.)) break;
+			case VE_FUN1: {
+				double (*f)(double) = op->f;
+				VE_UNARY((*f)(a))
+				}break;
+			case VE_ATAN2: {
+				double* r = top - VE_BLOCK;
+				for (k=0; k < m; ++k) { r[k] = atan2(r[k], top[k]); }
+				top = r;
+				}break;
+			}
+		}
+		for (k=0; k < m; ++k) {
+			y[i0 + k] = stk_[k];
+		}
+	}
+}
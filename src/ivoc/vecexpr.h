@@ -0,0 +1,55 @@
+#ifndef vecexpr_h
+#define vecexpr_h
+
+/*
+ A hoc like arithmetic expression of $1, e.g. "exp(-$1/tau) * 2",
+ compiled once into a small postfix program which is evaluated over
+ blocks of elements. Used by Vector.apply, reduce, and the where family
+ so that an expression does not cost an interpreter call per element.
+ Supports + - * / ^, unary - and !, the relational operators, && and ||,
+ parentheses, numbers, hoc scalar variables (value taken at compile time),
+ one argument built in functions (sin, exp, log, ...) and atan2.
+*/
+
+struct VecExprOp;
+
+class VecExpr {
+public:
+	VecExpr();
+	virtual ~VecExpr();
+
+	// replaces the previous program. hoc_execerror if malformed.
+	// Errors longjmp past the caller, so keep the instance around and
+	// reuse it rather than constructing one per call.
+	void compile(const char* expr);
+
+	// y[i] = expr evaluated with $1 = x[i]. y may be x.
+	void eval(const double* x, double* y, int n);
+
+	// true if s is an expression rather than the name of a function
+	static bool is_expression(const char* s);
+private:
+	void emit(int code, double val = 0.);
+	void orexpr();
+	void andexpr();
+	void relexpr();
+	void addexpr();
+	void mulexpr();
+	void unary();
+	void power();
+	void primary();
+	void skipblank();
+	bool accept(const char*);
+	void expect(const char*);
+	void error(const char*);
+private:
+	const char* expr_;
+	const char* p_;
+	VecExprOp* op_;
+	int nop_, maxop_;
+	int depth_, maxdepth_;
+	double* stk_;
+	int stksize_;
+};
+
+#endif
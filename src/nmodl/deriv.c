@@ -952,6 +952,10 @@ Symbol*ds, *s; Item* qbegin, *qend; {
 	if (c) {
 		lappendstr(procfunc, c);
 		lappendstr(procfunc, "))");
+		if (!cvode_eqnrhs()) {
+			/* derivative exact but not of the form a*state + b */
+			cvode_cnexp_possible = 0;
+		}
 		return 1;
 	}
 	cvode_cnexp_possible = 0;
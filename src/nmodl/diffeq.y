@@ -4,9 +4,14 @@
    a*state + b
 
   The only thing that makes this less than elegant is dealing with 0.0
+
+  Functions of the state are differentiated with the chain rule when they
+  are one of the elementary functions known to dfunc(). Otherwise the
+  derivative is invalid and the caller falls back to a finite difference.
 */
 
 #include <../../nmodlconf.h>
+#include <stdarg.h>
 #include <string.h>
 #include "modl.h"
 #include "difeqdef.h"
@@ -16,17 +21,18 @@
 static int yylex(), yyparse();
 static void yyerror();
 static int d_invalid, eq_invalid;
-static char lbuf[4][1000];
+static char lbuf[4][10000];
 static Item* qexpr; /* yylex finds tokens here;*/
 static Symbol* state;
 static List* result;
 
-#define b1 sprintf(lbuf[0],
-#define b2 sprintf(lbuf[1],
-#define b3 sprintf(lbuf[2],
-#define b4 sprintf(lbuf[3],
+static void bprintf(int, const char*, ...);
+#define b1 bprintf(0,
+#define b2 bprintf(1,
+#define b3 bprintf(2,
+#define b4 bprintf(3,
 
-static void replace(), initbuf(), free4();
+static void replace(), initbuf(), free4(), dfunc();
 static int zero();
 static char *expr(), *de(), *a(), *b();
 static List* list4();
@@ -58,6 +64,7 @@ e:	  ATOM {$$ = $1;}
 		
 	| ATOM '(' arglist ')' { $$ = $3; initbuf();
 		b1 "%s ( %s )", expr($1), expr($$));
+		if (!zero(de($$))) { dfunc(expr($1), $$); }
 		{b4 "%s ( %s )", expr($1), expr($$));}
 		free4($1); replace($$);
 	    }
@@ -117,7 +124,11 @@ b2 "((%s)*(%s) + (%s)*(%s))", de($1), expr($3), expr($1), de($3));
 	| e '/' e { $$ = $1; initbuf();
 		b1 "%s / %s", expr($1), expr($3));
 
-		if (!zero(de($3))) { d_invalid = 1;
+		if (!zero(de($3)) && !zero(de($1))) {
+b2 "((%s)*(%s) - (%s)*(%s)) / ((%s)*(%s))", de($1), expr($3), expr($1), de($3),
+  expr($3), expr($3));
+		}else if (!zero(de($3))) {
+b2 "( - (%s)*(%s)) / ((%s)*(%s))", expr($1), de($3), expr($3), expr($3));
 		}else if (!zero(de($1))) { b2 "( %s ) / %s", de($1), expr($3));}
 
 		if (!zero(a($3))) { eq_invalid = 1;
@@ -128,36 +139,94 @@ b2 "((%s)*(%s) + (%s)*(%s))", de($1), expr($3), expr($1), de($3));
 	    }
 	;
 
+/* for an arglist, de is the derivative of the first argument, a is the
+   first argument and b is the last argument. A dependence on the state
+   of any but the first argument makes the derivative invalid. */
 arglist: /*nothing*/ {
-		$$ = list4("", "0.0", "0.0", "");
+		$$ = list4("", "0.0", "", "");
 		}
 	| arg { $$ = $1; }
-	| arglist arg {
-		$$ = $2;
+	| arglist arg { $$ = $2; initbuf();
 		b1 "%s %s", expr($1), expr($2));
-		b4 "%s %s", expr($1), expr($2));
+		if (!zero(de($2))) { d_invalid = 1; }
+		b2 "%s", de($1));
+		b3 "%s", a($1));
+		b4 "%s", expr($2));
 		free4($1); replace($$);
 		}
-	| arglist ',' arg {
-		$$ = $3;
+	| arglist ',' arg { $$ = $3; initbuf();
 		b1 "%s , %s", expr($1), expr($3));
-		b4 "%s , %s", expr($1), expr($3));
+		if (!zero(de($3))) { d_invalid = 1; }
+		b2 "%s", de($1));
+		b3 "%s", a($1));
+		b4 "%s", expr($3));
 		free4($1); replace($$);
 		}
 	;	
 arg:	e { $$ = $1; initbuf();
 		b1 "%s", expr($1));
-		if (!zero(de($$))) { d_invalid = 1; }
+		if (!zero(de($$))) { b2 "%s", de($$)); }
 		if (!zero(de($$))) { eq_invalid = 1; }
-		{b4 "%s", expr($$));}
+		b3 "%s", expr($$));
+		b4 "%s", expr($$));
+		replace($$);
 	    }
 	;
 %%
 
+/* sprintf into lbuf[i] with a diagnostic instead of an overflow */
+static void bprintf(int i, const char* fmt, ...) {
+	va_list ap;
+	int n;
+	va_start(ap, fmt);
+	n = vsnprintf(lbuf[i], sizeof(lbuf[i]), fmt, ap);
+	va_end(ap);
+	if (n < 0 || n >= (int)sizeof(lbuf[i])) {
+		diag("expression too long to differentiate with respect to ",
+		  state->name);
+	}
+}
+
 static int zero(cp) char* cp; {
 	return (strcmp(cp, "0.0") == 0) ? 1 : 0;
 }
 
+/* d f(u)/dstate = f'(u) * du/dstate. Result in lbuf[1] */
+static void dfunc(name, args) char* name; List* args; {
+	char* u = a(args);
+	char* du = de(args);
+	char *c, *e;
+	size_t nu;
+	if (strcmp(expr(args), u) == 0) { /* one argument */
+		if (strcmp(name, "exp") == 0) {
+			b2 "exp ( %s ) * ( %s )", u, du);
+		}else if (strcmp(name, "log") == 0) {
+			b2 "( %s ) / ( %s )", du, u);
+		}else if (strcmp(name, "sqrt") == 0) {
+			b2 "( %s ) / ( 2.0 * sqrt ( %s ) )", du, u);
+		}else if (strcmp(name, "sin") == 0) {
+			b2 "cos ( %s ) * ( %s )", u, du);
+		}else if (strcmp(name, "cos") == 0) {
+			b2 "( - sin ( %s ) ) * ( %s )", u, du);
+		}else if (strcmp(name, "tanh") == 0) {
+			b2 "( 1.0 - tanh ( %s ) * tanh ( %s ) ) * ( %s )", u, u, du);
+		}else{
+			d_invalid = 1;
+		}
+		return;
+	}
+	/* two arguments if expr(args) is "u , c" */
+	c = b(args);
+	e = expr(args);
+	nu = strlen(u);
+	if (strcmp(name, "pow") == 0 && strncmp(e, u, nu) == 0
+	    && strncmp(e + nu, " , ", 3) == 0 && strcmp(e + nu + 3, c) == 0) {
+		b2 "( %s ) * pow ( %s , ( %s ) - 1.0 ) * ( %s )", c, u, c, du);
+	}else{
+		d_invalid = 1;
+	}
+}
+
 static char* expr(lst) List* lst; {
 	Item* q = lst->next;
 	return STR(q);
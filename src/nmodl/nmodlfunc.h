@@ -136,5 +136,6 @@ void pushlocal();
 void poplocal();
 
 void conductance_hint(int blocktype, Item* q1, Item* q2);
+void ohmic_conductance();
 void possible_local_current(int blocktype, List* symlist);
 Symbol* breakpoint_current(Symbol* s);
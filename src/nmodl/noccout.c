@@ -689,6 +689,9 @@ P("#include \"md2redef.h\"\n");
 	P("}\n");
 	P("}\n");
 
+	/* ohmic currents do not need the finite difference for di/dv */
+	ohmic_conductance();
+
 	/* standard modl EQUATION without solve computes current */
      if (!conductance_) {
 	P("\nstatic double _nrn_current(double* _p, Datum* _ppvar, Datum* _thread, _NrnThread* _nt, double _v){double _current=0.;v=_v;");
@@ -778,6 +781,18 @@ diag("current can only be LOCAL in a BREAKPOINT if CONDUCTANCE statements are us
 		P("   *_nd->_extnode->_rhs[0] += _rhs;\n");
 		P(" }\n");
 		P("#endif\n");
+		/* fused with nrn_jacob. Never when extracellular is present */
+		P(" if (_nt->_fused_jacob) {\n");
+		P("#if CACHEVEC\n");
+		P("  if (use_cachevec) {\n");
+		P("	VEC_D(_ni[_iml]) -= _g;\n");
+		P("  }else\n");
+		P("#endif\n");
+		P("  {\n");
+		P("	NODED(_nd) -= _g;\n");
+		P("  }\n");
+		P("  if (_nt->_nrn_fast_imem) { _nt->_nrn_fast_imem->_nrn_sav_d[_ni[_iml]] -= _g; }\n");
+		P(" }\n");
 	}else{
 #if CACHEVEC == 0
 		P("	NODERHS(_nd) -= _rhs;\n");
@@ -791,6 +806,17 @@ diag("current can only be LOCAL in a BREAKPOINT if CONDUCTANCE statements are us
 		P("	NODERHS(_nd) -= _rhs;\n");
 		P("  }\n");
 #endif
+		/* fused with nrn_jacob */
+		P(" if (_nt->_fused_jacob) {\n");
+		P("#if CACHEVEC\n");
+		P("  if (use_cachevec) {\n");
+		P("	VEC_D(_ni[_iml]) += _g;\n");
+		P("  }else\n");
+		P("#endif\n");
+		P("  {\n");
+		P("	NODED(_nd) += _g;\n");
+		P("  }\n");
+		P(" }\n");
 	}
    }
 	P(" \n}\n");
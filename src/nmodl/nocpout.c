@@ -139,6 +139,10 @@ List *currents;
 List *useion;
 List* conductance_;
 List* breakpoint_local_current_;
+extern List* modelfunc;
+#if CVODE
+extern Symbol* cvode_nrn_current_solve_;
+#endif
 static List *rangeparm;
 static List *rangedep;
 static List *rangestate;
@@ -1124,6 +1128,9 @@ Lappendstr(defs_list, "	hoc_register_synonym(_mechtype, _ode_synonym);\n");
 		Lappendstr(defs_list, "\
 	hoc_register_cvode(_mechtype, _ode_count, 0, 0, 0);\n");
 	}
+	if (vectorize && brkpnt_exists && currents->next != currents) {
+		Lappendstr(defs_list, "	hoc_register_fused_jacob(_mechtype);\n");
+	}
 	if (singlechan_) {
 		sprintf(buf, "hoc_reg_singlechan(_mechtype, _singlechan_declare%d);\n", singlechan_);
 		Lappendstr(defs_list, buf);
@@ -2734,6 +2741,162 @@ void conductance_hint(int blocktype, Item* q1, Item* q2) {
 	deltokens(q1, q2);
 }
 
+static int is_name(Item* q, const char* name) {
+	return q->itemtype == SYMBOL && (!name || strcmp(SYM(q)->name, name) == 0);
+}
+
+static int is_identifier(Item* q) {
+	int c;
+	if (q->itemtype != SYMBOL) { return 0; }
+	c = SYM(q)->name[0];
+	return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+static int is_number(Item* q) {
+	char* cp;
+	if (q->itemtype != STRING) { return 0; }
+	strtod(STR(q), &cp);
+	while (*cp == ' ') { ++cp; }
+	return cp != STR(q) && *cp == '\0';
+}
+
+/*
+If every current in the BREAKPOINT block is assigned once as
+	i = g*(v - e)
+where g and e are names and nothing else in the block depends on v
+or calls a function, then di/dv = g exactly and nrn_cur does not have to
+evaluate the block twice. Construct the equivalent of the statements
+	CONDUCTANCE g [USEION ion]
+Anything more complicated keeps the finite difference.
+*/
+void ohmic_conductance() {
+	Item *q, *q1, *qbegin, *qend, *qcur;
+	List* g;
+	Symbol* s;
+	int n;
+
+	if (conductance_ || breakpoint_local_current_ || !brkpnt_exists
+	  || currents->next == currents) {
+		return;
+	}
+#if CVODE
+	if (cvode_nrn_current_solve_ || state_discon_list_) {
+		return;
+	}
+#endif
+	/* the block is enclosed in { } */
+	qbegin = modelfunc->next;
+	qend = modelfunc->prev;
+	if (qbegin == modelfunc || !is_name(qbegin, "{") || !is_name(qend, "}")) {
+		return;
+	}
+	g = newlist(); /* pairs of current, conductance */
+	for (q = qbegin->next; q != qend; q = q->next) {
+		/* name = expr ; */
+		if (!is_identifier(q) || !is_name(q->next, "=")) {
+			return;
+		}
+		s = SYM(q);
+		if (strcmp(s->name, "v") == 0 || (s->subtype & ARRAY)) {
+			return;
+		}
+		qcur = (Item*)0;
+		ITERATE(q1, currents) {
+			if (SYM(q1) == s) {
+				qcur = q1;
+			}
+		}
+		ITERATE(q1, g) {
+			if (SYM(q1) == s) {
+				return; /* a current assigned twice */
+			}
+			q1 = q1->next;
+			if (SYM(q1) == s) {
+				return; /* conductance assigned after use */
+			}
+		}
+		q = q->next->next;
+		if (qcur) {
+			/* g * ( v - e ) ; */
+			Item* qg = q;
+			Item* qe;
+			for (n = 0; n < 7; ++n, q = q->next) {
+				if (q == qend) { return; }
+			}
+			if (!is_name(q, ";")) { return; }
+			qe = qg->next->next->next->next->next;
+			if (!is_identifier(qg) || !is_name(qg->next, "*")
+			  || !is_name(qg->next->next, "(")
+			  || !is_name(qg->next->next->next, "v")
+			  || !is_name(qg->next->next->next->next, "-")
+			  || !is_identifier(qe) || !is_name(qe->next, ")")
+			  || strcmp(SYM(qg)->name, "v") == 0
+			  || strcmp(SYM(qe)->name, "v") == 0) {
+				return;
+			}
+			ITERATE(q1, currents) {
+				if (SYM(q1) == SYM(qg) || SYM(q1) == SYM(qe)) {
+					return;
+				}
+			}
+			lappendsym(g, s);
+			lappendsym(g, SYM(qg));
+		}else{
+			/* no v, no currents, no function calls, no blocks */
+			for (; q != qend && !is_name(q, ";"); q = q->next) {
+				if (is_identifier(q)) {
+					if (strcmp(SYM(q)->name, "v") == 0
+					  || is_name(q->next, "(")) {
+						return;
+					}
+					ITERATE(q1, currents) {
+						if (SYM(q1) == SYM(q)) {
+							return;
+						}
+					}
+				}else if (q->itemtype == SYMBOL) {
+					if (strchr("+-*/^()", SYM(q)->name[0]) == 0
+					  || SYM(q)->name[1] != '\0') {
+						return;
+					}
+				}else if (!is_number(q)) {
+					return;
+				}
+			}
+			if (q == qend) { return; }
+		}
+	}
+	/* every current must have been assigned */
+	ITERATE(q, currents) {
+		n = 0;
+		ITERATE(q1, g) {
+			if (SYM(q1) == SYM(q)) {
+				n = 1;
+			}
+			q1 = q1->next;
+		}
+		if (!n) { return; }
+	}
+
+	conductance_ = newlist();
+	ITERATE(q, g) {
+		Item *qion, *qw;
+		s = SYM0;
+		ITERATE(qion, useion) {
+			qw = qion->next->next;
+			ITERATE(q1, LST(qw)) {
+				if (SYM(q1) == SYM(q) && (SYM(q1)->nrntype & NRNCUROUT)) {
+					s = SYM(qion);
+				}
+			}
+			qion = qw->next;
+		}
+		q = q->next;
+		lappendsym(conductance_, SYM(q));
+		lappendsym(conductance_, s);
+	}
+}
+
 void possible_local_current(int blocktype, List* symlist) {
 	Item* q; Item* q2;
 	if (blocktype != BREAKPOINT) { return; }
@@ -476,6 +476,17 @@ static Object** netconlist(void* v) {
 	return d->netconlist();
 }
 
+static double netcon_compact(void* v) {
+	NetCvode* d = (NetCvode*)v;
+	return double(d->netcon_compact());
+}
+
+static double netcon_compact_remove(void* v) {
+	NetCvode* d = (NetCvode*)v;
+	d->netcon_compact_remove();
+	return 0.;
+}
+
 static double ncs_netcons(void* v) {
 #if USENCS
 	nrn2ncs_netcons();
@@ -567,6 +578,14 @@ static double use_fast_imem(void* v) {
 	return double(i);
 }
 
+static double use_fused_jacob(void* v) {
+	int i = nrn_use_fused_jacob;
+	if (ifarg(1)) {
+		nrn_use_fused_jacob = int(chkarg(1, 0., 1.));
+	}
+	return double(i);
+}
+
 static Member_func members[] = {
 	"solve", solve,
 	"atol", nrn_atol,
@@ -601,6 +620,8 @@ static Member_func members[] = {
 	"simgraph_remove", simgraph_remove,
 	"state_magnitudes", state_magnitudes,
 	"ncs_netcons", ncs_netcons,
+	"netcon_compact", netcon_compact,
+	"netcon_compact_remove", netcon_compact_remove,
 	"statistics", statistics,
 	"spike_stat", spikestat,
 	"queue_mode", queue_mode,
@@ -616,6 +637,7 @@ static Member_func members[] = {
 	"extra_scatter_gather", extra_scatter_gather,
 	"extra_scatter_gather_remove", extra_scatter_gather_remove,
 	"use_fast_imem", use_fast_imem,
+	"use_fused_jacob", use_fused_jacob,
 	0,0
 };
 
@@ -673,6 +695,7 @@ static void* msolve_thread_part1(NrnThread*);
 static void* msolve_thread_part2(NrnThread*);
 static void* msolve_thread_part3(NrnThread*);
 static void* f_thread(NrnThread*);
+static void* f_thread_transfer(NrnThread*);
 static void* f_thread_transfer_part1(NrnThread*);
 static void* f_thread_transfer_part2(NrnThread*);
 static void* f_thread_ms_part1(NrnThread*);
@@ -1416,7 +1439,12 @@ static int msolve(CVodeMem m, N_Vector b, N_Vector weight, N_Vector ycur, N_Vect
 	msolve_ycur_ = ycur;
 	if (nrn_multisplit_setup_ && nrn_nthread > 1) {
 		nrn_multithread_job(msolve_thread_part1);
-		nrn_multithread_job(msolve_thread_part2);
+		if (nrn_thread_publish_begin()) {
+			nrn_multithread_job(msolve_thread_part2);
+			nrn_thread_publish_end();
+		}else{
+			nrn_multithread_job(msolve_thread_part2);
+		}
 		nrn_multithread_job(msolve_thread_part3);
 	}else{
 		nrn_multithread_job(msolve_thread);
@@ -1495,11 +1523,18 @@ static void f_gvardt(realtype t, N_Vector y, N_Vector ydot, void *f_data) {
 				nrn_multithread_job(f_thread_ms_part34);
 			}
 		}else if (nrnthread_v_transfer_) {
-			nrn_multithread_job(f_thread_transfer_part1);
-			if (nrnmpi_v_transfer_) {
-				(*nrnmpi_v_transfer_)();
+			// Without mpi, a thread only has to wait for the
+			// threads owning its gap junction sources, not all.
+			if (!nrnmpi_v_transfer_ && nrn_thread_publish_begin()) {
+				nrn_multithread_job(f_thread_transfer);
+				nrn_thread_publish_end();
+			}else{
+				nrn_multithread_job(f_thread_transfer_part1);
+				if (nrnmpi_v_transfer_) {
+					(*nrnmpi_v_transfer_)();
+				}
+				nrn_multithread_job(f_thread_transfer_part2);
 			}
-			nrn_multithread_job(f_thread_transfer_part2);
 		}else{
 			nrn_multithread_job(f_thread);
 		}
@@ -1525,6 +1560,16 @@ static void* f_thread(NrnThread* nt) {
 	nt->_vcv = 0;
 	return 0;
 }
+static void* f_thread_transfer(NrnThread* nt) {
+	int i = nt->id;
+	Cvode* cv = f_cv_;
+	nt->_vcv = cv;
+	cv->fun_thread_transfer_part1(f_t_, cv->n_vector_data(f_y_, i), nt);
+	nrn_thread_publish(nt);
+	cv->fun_thread_transfer_part2(cv->n_vector_data(f_ydot_, i), nt);
+	nt->_vcv = 0;
+	return 0;
+}
 static void* f_thread_transfer_part1(NrnThread* nt) {
 	int i = nt->id;
 	Cvode* cv = f_cv_;
@@ -41,9 +41,12 @@ static void check_thresh(NrnThread*);
 // for fixed step thread
 void deliver_net_events(NrnThread* nt) {
 	int i;
+	unsigned long long t0;
 	if (net_cvode_instance) {
+		net_cvode_instance->prof_events_begin(nt, t0);
 		net_cvode_instance->check_thresh(nt);
 		net_cvode_instance->deliver_net_events(nt);
+		net_cvode_instance->prof_events_end(nt, t0);
 	}
 }
 
@@ -63,13 +63,16 @@ void Cvode::rhs(NrnThread* _nt) {
 
 void Cvode::rhs_memb(CvMembList* cmlist, NrnThread* _nt) {
 	CvMembList* cml;
+	unsigned long long t0;
 	errno = 0;
 	for (cml = cmlist; cml; cml = cml->next) {
 		Memb_func* mf = memb_func + cml->index;
 		Pfridot s = (Pfridot)mf->current;
 		if (s) {
 			Memb_list* ml = cml->ml;
+			NRN_PROF_BEGIN(t0)
 			(*s)(_nt, ml, cml->index);
+			NRN_PROF_END(t0, _nt, NRN_PROF_CUR, cml->index)
 			if (errno) {
 				if (nrn_errno_check(cml->index)) {
 hoc_warning("errno set during calculation of currents", (char*)0);
@@ -108,13 +111,16 @@ void Cvode::lhs(NrnThread* _nt) {
 
 void Cvode::lhs_memb(CvMembList* cmlist, NrnThread* _nt) {
 	CvMembList* cml;
+	unsigned long long t0;
 	for (cml = cmlist; cml; cml = cml->next) {
 		Memb_func* mf = memb_func + cml->index;
 		Memb_list* ml = cml->ml;
 		Pfridot s = (Pfridot)mf->jacob;
 		if (s) {
 			Pfridot s = (Pfridot)mf->jacob;
+			NRN_PROF_BEGIN(t0)
 			(*s)(_nt, ml, cml->index);
+			NRN_PROF_END(t0, _nt, NRN_PROF_JACOB, cml->index)
 			if (errno) {
 				if (nrn_errno_check(cml->index)) {
 hoc_warning("errno set during calculation of di/dv", (char*)0);
@@ -104,6 +104,7 @@ public:
 	Object* obj_;
 	int cnt_;
 	bool active_;
+	bool compact_; // element of a NetConBlock, weight_ not owned
 
 	static unsigned long netcon_send_active_;
 	static unsigned long netcon_send_inactive_;
@@ -159,6 +160,15 @@ private:
 
 declarePtrList(NetConPList, NetCon)
 
+// NetCon allocated contiguously, without hoc objects, by
+// NetCvode::netcon_compact. Hoc objects are created only on request.
+struct NetConBlock {
+	NetCon* nc_;
+	double* weight_;
+	int cnt_;
+};
+declarePtrList(NetConBlockList, NetConBlock)
+
 class ConditionEvent : public DiscreteEvent {
 public:
 	// condition detection factored out of PreSyn for re-use
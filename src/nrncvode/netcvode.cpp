@@ -51,7 +51,7 @@ typedef void (*ReceiveFunc)(Point_process*, double*, double);
 #define UNLOCK(m) /**/
 // classical and when DiscreteEvent::deliver is already in the right thread
 // via a future thread instance of NrnNetItem with its own tqe.
-#define POINT_RECEIVE(type, tar, w, f) (*pnt_receive[type])(tar, w, f)
+#define POINT_RECEIVE(type, tar, w, f) nrn_point_receive(type, tar, w, f)
 // when global tqe is managed by master thread and the correct thread
 // needs to be fired to execute the NET_RECEIVE block.
 //#define POINT_RECEIVE(type, tar, w, f) ns->point_receive(type, tar, w, f)
@@ -102,6 +102,9 @@ extern Symlist* hoc_built_in_symlist;
 extern Symlist* hoc_top_level_symlist;
 extern TQueue* net_cvode_instance_event_queue(NrnThread*);
 extern hoc_Item* net_cvode_instance_psl();
+extern void nrn_psl_thr_invalid();
+extern void nrn_netcon_compact_materialize();
+extern Object* hoc_new_object(Symbol*, void*);
 extern PlayRecList* net_cvode_instance_prl();
 extern void nrn_update_ps2nt();
 extern void nrn_use_busywait(int);
@@ -118,6 +121,18 @@ extern int* nrn_fornetcon_type_;
 void _nrn_free_fornetcon(void**);
 int _nrn_netcon_args(void*, double***);
 
+// NET_RECEIVE with its time accumulated when profiling.
+static void nrn_point_receive(int type, Point_process* pp, double* w, double f) {
+	unsigned long long t0;
+	if (nrn_prof_on_ && PP2NT(pp)) {
+		t0 = nrn_prof_clock();
+		(*pnt_receive[type])(pp, w, f);
+		NRN_PROF_END(t0, PP2NT(pp), NRN_PROF_NETRECEIVE, type)
+	}else{
+		(*pnt_receive[type])(pp, w, f);
+	}
+}
+
 // for use in mod files
 double nrn_netcon_get_delay(NetCon* nc) { return nc->delay_; }
 void nrn_netcon_set_delay(NetCon* nc, double d) { nc->delay_ = d; }
@@ -143,6 +158,7 @@ double nrn_netcon_get_thresh(NetCon* nc) {
 void nrn_netcon_set_thresh(NetCon* nc, double th) {
 	if (nc->src_) {
 		nc->src_->threshold_ = th;
+		net_cvode_instance->psl_thr_invalid();
 	}
 }
 
@@ -293,6 +309,10 @@ hoc_Item* net_cvode_instance_psl() {
 	return net_cvode_instance->psl_;
 }
 
+void nrn_psl_thr_invalid() {
+	net_cvode_instance->psl_thr_invalid();
+}
+
 PlayRecList* net_cvode_instance_prl() {
 	return net_cvode_instance->playrec_list();
 }
@@ -411,6 +431,7 @@ printf(" weight index=%d\n", l);
 #endif
 
 implementPtrList(NetConPList, NetCon)
+implementPtrList(NetConBlockList, NetConBlock)
 
 class MaxStateItem {
 public:
@@ -521,9 +542,7 @@ static Object** nc_prelist(void* v) {
 	if (d->src_) {
 		NetConPList& dil = d->src_->dil_;
 		for (int i=0; i < dil.count(); ++i) {
-			if (dil.item(i)->obj_) {
-				o->append(dil.item(i)->obj_);
-			}
+			o->append(net_cvode_instance->netcon_obj(dil.item(i)));
 		}
 	}
 	return po;
@@ -539,8 +558,8 @@ static Object** nc_synlist(void* v) {
 		NetConPList& dil = ps->dil_;
 		for (int i=0; i < dil.count(); ++i) {
 			NetCon* d1 = dil.item(i);
-			if (d1->obj_ && d1->target_ == d->target_) {
-				o->append(d1->obj_);
+			if (d1->target_ == d->target_) {
+				o->append(net_cvode_instance->netcon_obj(d1));
 			}
 		}
 	}
@@ -561,9 +580,9 @@ static Object** nc_postcelllist(void* v) {
 		NetConPList& dil = ps->dil_;
 		for (int i=0; i < dil.count(); ++i) {
 			NetCon* d1 = dil.item(i);
-			if (d1->obj_ && d1->target_
+			if (d1->target_
 				&& nrn_sec2cell_equals(d1->target_->sec, cell)) {
-				o->append(d1->obj_);
+				o->append(net_cvode_instance->netcon_obj(d1));
 			}
 		}
 	}
@@ -582,9 +601,9 @@ static Object** nc_precelllist(void* v) {
 		NetConPList& dil = ps->dil_;
 		for (int i=0; i < dil.count(); ++i) {
 			NetCon* d1 = dil.item(i);
-			if (d1->obj_ && d1->src_ && ps->ssrc_
+			if (d1->src_ && ps->ssrc_
 				&& nrn_sec2cell_equals(ps->ssrc_, cell)) {
-				o->append(d1->obj_);
+				o->append(net_cvode_instance->netcon_obj(d1));
 			}
 		}
 	}
@@ -622,15 +641,18 @@ static double nc_setpost(void* v) {
 	if (otar) {
 		tar = ob2pntproc(otar);
 	}
+	int cnt = tar ? pnt_receive_size[tar->prop->type] : 1;
+	if (d->compact_ && d->cnt_ != cnt) {
+		// its weights are part of the NetConBlock weight array
+hoc_execerror(hoc_object_name(d->obj_), "is compact and the new target needs a different number of weights");
+	}
 	if (d->target_ && d->target_ != tar) {
 #if DISCRETE_EVENT_OBSERVER
 		ObjObservable::Detach(d->target_->ob, d);
 #endif
 		d->target_ = nil;
 	}
-	int cnt = 1;
 	if (tar) {
-		cnt = pnt_receive_size[tar->prop->type];
 		d->target_ = tar;
 #if DISCRETE_EVENT_OBSERVER
 		ObjObservable::Attach(otar, d);
@@ -833,6 +855,10 @@ static void* cons(Object* o) {
 
 static void destruct(void* v) {
 	NetCon* d = (NetCon*)v;
+	if (d->compact_) { // the NetConBlock owns it
+		d->obj_ = nil;
+		return;
+	}
 	delete d;
 }
 
@@ -1024,7 +1050,7 @@ Object** NetCvode::netconlist() {
 						}
 					}
 					if (b == true) {
-						o->append(d->obj_);
+						o->append(netcon_obj(d));
 					}
 				}
 			}
@@ -1044,6 +1070,14 @@ NetCvodeThreadData::NetCvodeThreadData() {
 	sepool_ = new SelfEventPool(1000,1);
 	selfqueue_ = nil;
 	psl_thr_ = nil;
+	th_cnt_ = 0;
+	th_size_ = 0;
+	th_valid_ = false;
+	th_ps_ = nil;
+	th_var_ = nil;
+	th_thresh_ = nil;
+	th_flag_ = nil;
+	th_cross_ = nil;
 	tq_ = nil;
 	lcv_ = nil;
 	ite_size_ = ITE_SIZE;
@@ -1052,12 +1086,20 @@ NetCvodeThreadData::NetCvodeThreadData() {
 	immediate_deliver_ = -1e100;
 	inter_thread_events_ = new InterThreadEvent[ite_size_];
 	nlcv_ = 0;
+	prof_depth_ = 0;
 	MUTCONSTRUCT(1)
 }
 
 NetCvodeThreadData::~NetCvodeThreadData() {
 	delete [] inter_thread_events_;
 	if (psl_thr_) { hoc_l_freelist(&psl_thr_); }
+	if (th_size_) {
+		delete [] th_ps_;
+		delete [] th_var_;
+		delete [] th_thresh_;
+		delete [] th_flag_;
+		delete [] th_cross_;
+	}
 	if (tq_) { delete tq_; }
 	delete tqe_;
 	delete tpool_;
@@ -1157,6 +1199,7 @@ NetCvode::NetCvode(bool single) {
 	// eventually these should not have to be thread safe
 	pst_ = nil;
 	pst_cnt_ = 0;
+	ncbl_ = nil;
 	psl_ = nil;
 	// for parallel network simulations hardly any presyns have
 	// a threshold and it can be very inefficient to check the entire
@@ -1199,12 +1242,23 @@ NetCvode::~NetCvode() {
 			for (int i = ps->dil_.count() - 1; i >= 0; --i) {
 				NetCon* d = ps->dil_.item(i);
 				d->src_ = nil;
-				delete d;
+				if (!d->compact_) {
+					delete d;
+				}
 			}
 			delete ps;
 		}
 		hoc_l_freelist(&psl_);
 	}
+	if (ncbl_) {
+		for (int i = 0; i < ncbl_->count(); ++i) {
+			NetConBlock* b = ncbl_->item(i);
+			delete [] b->nc_;
+			delete [] b->weight_;
+			delete b;
+		}
+		delete ncbl_;
+	}
 	if (pst_) {
 		delete pst_;
 	}
@@ -2017,6 +2071,8 @@ for lvardt it is p[i].lcv_[jcell_in_thread_i].ctd_[0].
 */
 
 int NetCvode::solve(double tout) {
+	// variable step threshold detection changes the PreSyn flag_
+	psl_thr_invalid();
 	if (nrn_nthread > 1) {
 		return solve_when_threads(tout); // more or less a copy of below
 	}
@@ -2131,6 +2187,7 @@ void NetCvode::handle_tstop_event(double tt, NrnThread* nt) {
 }
 
 void NetCvode::deliver_least_event(NrnThread* nt) {
+	unsigned long long t0;
 	TQItem* q = p[nt->id].tqe_->least();
 	DiscreteEvent* de = (DiscreteEvent*)q->data_;
 	double tt = q->t_;
@@ -2139,7 +2196,9 @@ void NetCvode::deliver_least_event(NrnThread* nt) {
 	if (print_event_) { de->pr("deliver", tt, this); }
 #endif
 	STATISTICS(deliver_cnt_);
+	prof_events_begin(nt, t0);
 	de->deliver(tt, this, nt);
+	prof_events_end(nt, t0);
 }
 
 #if BGPDMA > 1
@@ -2746,6 +2805,7 @@ void NetCvode::clear_events() {
 		d.sepool_->free_all();
 		d.immediate_deliver_ = -1e100;
 		d.ite_cnt_ = 0;
+		d.prof_depth_ = 0;
 		if (nrn_use_selfqueue_) {
 			if (!d.selfqueue_) {
 				d.selfqueue_ = new SelfQueue(d.tpool_, 0);
@@ -2776,6 +2836,7 @@ void NetCvode::init_events() {
 		p[i].tqe_->shift_bin(nt_t);
 	}
 #endif
+	psl_thr_invalid(); // flag_ reset below
 	if (psl_) {
 		ITERATE(q, psl_) {
 			PreSyn* ps = (PreSyn*)VOIDITM(q);
@@ -2864,10 +2925,32 @@ double PreSyn::mindelay() {
 
 void NetCvode::deliver_events(double til, NrnThread* nt) {
 //printf("deliver_events til %20.15g\n", til);
+	unsigned long long t0;
+	prof_events_begin(nt, t0);
 	p[nt->id].enqueue(this, nt);
 	while(deliver_event(til, nt)) {
 		;
 	}
+	prof_events_end(nt, t0);
+}
+
+/*
+NRN_PROF_EVENTS time. Delivery nests, e.g. a NetParEvent or an allthread
+HocEvent delivers the other events at its time from within deliver_events,
+so only the outermost level of a thread is timed. clear_events resets the
+depth in case an error left a delivery unfinished.
+*/
+void NetCvode::prof_events_begin(NrnThread* nt, unsigned long long& t0) {
+	if (p[nt->id].prof_depth_++ == 0) {
+		t0 = 0;
+		NRN_PROF_BEGIN(t0)
+	}
+}
+
+void NetCvode::prof_events_end(NrnThread* nt, unsigned long long t0) {
+	if (--p[nt->id].prof_depth_ == 0 && t0) {
+		NRN_PROF_END(t0, nt, NRN_PROF_EVENTS, 0)
+	}
 }
 
 static IvocVect* peqvec; //if not nil then the sorted times on the event queue.
@@ -2912,7 +2995,7 @@ static void event_info_callback(const TQItem* q, int) {
 			nc = (NetCon*)d;
 			event_info_tvec_->resize_chunk(n+1);
 			event_info_tvec_->elem(n) = q->t_;
-			event_info_list_->append(nc->obj_);
+			event_info_list_->append(net_cvode_instance->netcon_obj(nc));
 		}
 		break;
 	case SelfEventType:
@@ -2933,7 +3016,7 @@ static void event_info_callback(const TQItem* q, int) {
 				double td = nc->delay_ - ps->delay_;
 				event_info_tvec_->resize_chunk(n+1);
 				event_info_tvec_->elem(n) = q->t_ + td;
-				event_info_list_->append(nc->obj_);
+				event_info_list_->append(net_cvode_instance->netcon_obj(nc));
 				++n;
 			}
 		}
@@ -4437,10 +4520,30 @@ void NetCvode::structure_change() {
 
 NetCon* NetCvode::install_deliver(double* dsrc, Section* ssrc, Object* osrc,
 	Object* target,	double threshold, double delay, double magnitude
+    ) {
+	PreSyn* ps = presyn_install(dsrc, ssrc, osrc, threshold);
+	if (!ps && target) { // no source so use the special presyn
+		if (!unused_presyn) {
+			unused_presyn = new PreSyn(nil, nil, nil);
+			unused_presyn->hi_ = hoc_l_insertvoid(psl_, unused_presyn);
+		}
+		ps = unused_presyn;
+	}
+	ps_thread_link(ps);
+	NetCon* d = new NetCon(ps, target);
+	d->delay_ = delay;
+	d->weight_[0] = magnitude;
+	structure_change_cnt_ = 0;
+	return d;
+}
+
+// the PreSyn for a source pointer or point process, created if necessary.
+// nil if there is no source.
+PreSyn* NetCvode::presyn_install(double* dsrc, Section* ssrc, Object* osrc,
+	double threshold
     ) {
 	PreSyn* ps = nil;
 	double* psrc = nil;
-	int i;
 	if (ssrc) { consist_sec_pd("NetCon", ssrc, dsrc); }
 	if (!pst_) {
 		pst_ = new PreSynTable(1000);
@@ -4469,30 +4572,243 @@ NetCon* NetCvode::install_deliver(double* dsrc, Section* ssrc, Object* osrc,
 			pst_->insert(psrc, ps);
 			++pst_cnt_;
 		}
-		if (threshold != -1e9) { ps->threshold_ = threshold; }
+		if (threshold != -1e9) {
+			ps->threshold_ = threshold;
+			psl_thr_invalid(); // the batched check caches it
+		}
 	}else if (osrc){
 		Point_process* pnt = ob2pntproc(osrc);
 		if (pnt->presyn_) {
 			ps = (PreSyn*)pnt->presyn_;
 		}else{
 			ps = new PreSyn(psrc, osrc, ssrc);
-			if (threshold != -1e9) { ps->threshold_ = threshold; }
+			if (threshold != -1e9) {
+				ps->threshold_ = threshold;
+				psl_thr_invalid();
+			}
 			ps->hi_ = hoc_l_insertvoid(psl_, ps);
 			pnt->presyn_ = ps;
 		}
-	}else if (target) { // no source so use the special presyn
-		if (!unused_presyn) {
-			unused_presyn = new PreSyn(nil, nil, nil);
-			unused_presyn->hi_ = hoc_l_insertvoid(psl_, unused_presyn);
+	}
+	return ps;
+}
+
+// n = cvode.netcon_compact(source, targetlist, delayvec, weightvec [, thresh])
+// Connects one source to every point process in targetlist without a
+// hoc NetCon object per connection. delayvec has one element or one per
+// target. weightvec has one element per target (the first weight) or the
+// weights of all the targets in order.
+int NetCvode::netcon_compact() {
+	Object* osrc = nil;
+	Section* srcsec = nil;
+	double* psrc = nil;
+	int i, n;
+	if (hoc_is_object_arg(1)) {
+		osrc = *hoc_objgetarg(1);
+		if (!osrc || !is_point_process(osrc)) {
+			hoc_execerror("if arg 1 is an object it must be a point process", 0);
 		}
-		ps = unused_presyn;
+	}else{
+		psrc = hoc_pgetarg(1);
+		srcsec = chk_access();
+	}
+	Object* o = *hoc_objgetarg(2);
+	check_obj_type(o, "List");
+	OcList* tlist = (OcList*)o->u.this_pointer;
+	Vect* vdel = vector_arg(3);
+	Vect* vwt = vector_arg(4);
+	double thresh = ifarg(5) ? *getarg(5) : -1e9;
+	n = tlist->count();
+	if (n == 0) {
+		return 0;
+	}
+	if (vdel->capacity() != 1 && vdel->capacity() != n) {
+hoc_execerror("delay Vector size must be 1 or the number of targets", 0);
+	}
+	int ntw = 0;
+	for (i=0; i < n; ++i) {
+		ntw += netcon_compact_check(tlist->object(i),
+			vdel->elem(vdel->capacity() == 1 ? 0 : i));
+	}
+	if (vwt->capacity() != n && vwt->capacity() != ntw) {
+hoc_execerror("weight Vector size must be the number of targets or the total number of weights", 0);
+	}
+	Object** targets = new Object*[n];
+	double* del = new double[n];
+	for (i=0; i < n; ++i) {
+		targets[i] = tlist->object(i);
+		del[i] = vdel->elem(vdel->capacity() == 1 ? 0 : i);
+	}
+	PreSyn* ps = presyn_install(psrc, srcsec, osrc, thresh);
+	n = netcon_compact(ps, n, targets, del, vector_vec(vwt), vwt->capacity());
+	delete [] targets;
+	delete [] del;
+	return n;
+}
+
+// Error if netcon_compact would fail for this target, so callers can
+// check every target before creating or allocating anything. Returns
+// the number of weights of the target.
+int NetCvode::netcon_compact_check(Object* ot, double delay) {
+	if (!is_point_process(ot)) {
+		hoc_execerror(hoc_object_name(ot), "is not a point process");
+	}
+	Point_process* pnt = ob2pntproc(ot);
+	if (!pnt_receive[pnt->prop->type]) {
+hoc_execerror("No NET_RECEIVE in target PointProcess:", hoc_object_name(ot));
+	}
+	if (delay < 0.) {
+		hoc_execerror("delay must be >= 0", 0);
+	}
+	return pnt_receive_size[pnt->prop->type];
+}
+
+// n NetCon from ps to the targets, allocated as one contiguous block along
+// with their weights. weight has nw elements, either one per target
+// (the first weight) or all the weights of all the targets in order.
+// Every target must have passed netcon_compact_check.
+int NetCvode::netcon_compact(PreSyn* ps, int n, Object** targets,
+	double* delay, double* weight, int nw
+    ) {
+	int i, j, ntw;
+	ntw = 0;
+	for (i=0; i < n; ++i) {
+		ntw += pnt_receive_size[ob2pntproc(targets[i])->prop->type];
 	}
 	ps_thread_link(ps);
-	NetCon* d = new NetCon(ps, target);
-	d->delay_ = delay;
-	d->weight_[0] = magnitude;
+	NetConBlock* b = new NetConBlock;
+	b->cnt_ = n;
+	b->nc_ = new NetCon[n];
+	b->weight_ = ntw ? new double[ntw] : nil;
+	double* w = b->weight_;
+	double* wt = weight;
+	for (i=0; i < n; ++i) {
+		NetCon* d = b->nc_ + i;
+		Object* ot = targets[i];
+		d->compact_ = true;
+		d->src_ = ps;
+		d->target_ = ob2pntproc(ot);
+		d->active_ = true;
+		d->delay_ = delay[i];
+		d->cnt_ = pnt_receive_size[d->target_->prop->type];
+		d->weight_ = d->cnt_ ? w : nil;
+		for (j=0; j < d->cnt_; ++j) {
+			w[j] = (nw == n) ? 0. : *wt++;
+		}
+		if (nw == n && d->cnt_) {
+			w[0] = weight[i];
+		}
+		w += d->cnt_;
+#if DISCRETE_EVENT_OBSERVER
+		ObjObservable::Attach(ot, d);
+#endif
+		ps->dil_.append(d);
+	}
+	ps->use_min_delay_ = 0;
+	if (!ncbl_) {
+		ncbl_ = new NetConBlockList();
+	}
+	ncbl_->append(b);
+	structure_change_cnt_ = 0;
+	return n;
+}
+
+// Delete all the NetCon created by netcon_compact.
+void NetCvode::netcon_compact_remove() {
+	int i, j, k;
+	if (!ncbl_) {
+		return;
+	}
+	for (i=0; i < ncbl_->count(); ++i) {
+		NetConBlock* b = ncbl_->item(i);
+		for (j=0; j < b->cnt_; ++j) {
+			Object* ob = b->nc_[j].obj_;
+			if (ob && ob->refcount > 1) {
+hoc_execerror(hoc_object_name(ob), "is still referenced so the compact NetCon cannot be removed");
+			}
+		}
+	}
+	for (i=0; i < ncbl_->count(); ++i) {
+		NetConBlock* b = ncbl_->item(i);
+		// the NetCon all start with the same source but replace_src
+		// may have moved some of them to another PreSyn.
+		PreSynList psl(1);
+		for (j=0; j < b->cnt_; ++j) {
+			PreSyn* ps = b->nc_[j].src_;
+			for (k=0; ps && k < psl.count(); ++k) {
+				if (psl.item(k) == ps) {
+					ps = nil;
+				}
+			}
+			if (ps) {
+				psl.append(ps);
+			}
+		}
+		// remove the whole block from each dil_ in one pass instead of
+		// one search per NetCon in rmsrc.
+		for (k=0; k < psl.count(); ++k) {
+			PreSyn* ps = psl.item(k);
+			NetConPList& dil = ps->dil_;
+			NetConPList keep(dil.count());
+			for (j=0; j < dil.count(); ++j) {
+				NetCon* d = dil.item(j);
+				if (d < b->nc_ || d >= b->nc_ + b->cnt_) {
+					keep.append(d);
+				}
+			}
+			dil.remove_all();
+			for (j=0; j < keep.count(); ++j) {
+				dil.append(keep.item(j));
+			}
+			ps->use_min_delay_ = 0;
+		}
+		for (j=0; j < b->cnt_; ++j) {
+			NetCon* d = b->nc_ + j;
+			d->src_ = nil;
+			if (d->obj_) {
+				hoc_obj_unref(d->obj_); // destruct only sets obj_ to nil
+			}
+		}
+		delete [] b->nc_;
+		delete [] b->weight_;
+		delete b;
+		for (k=0; k < psl.count(); ++k) {
+			PreSyn* ps = psl.item(k);
+			if (ps->dil_.count() == 0 && ps->tvec_ == nil
+			    && ps->idvec_ == nil && ps->output_index_ == -1) {
+				delete ps;
+			}
+		}
+	}
+	ncbl_->remove_all();
 	structure_change_cnt_ = 0;
-	return d;
+}
+
+// The hoc object for a NetCon. Compact NetCon get one when first asked
+// for. It is referenced by the NetConBlock and so lives until
+// netcon_compact_remove.
+Object* NetCvode::netcon_obj(NetCon* d) {
+	if (!d->obj_) {
+		assert(d->compact_);
+		d->obj_ = hoc_new_object(hoc_lookup("NetCon"), d);
+		hoc_obj_ref(d->obj_);
+		NetConSave::invalid();
+	}
+	return d->obj_;
+}
+
+void NetCvode::netcon_compact_materialize() {
+	if (ncbl_) for (int i=0; i < ncbl_->count(); ++i) {
+		NetConBlock* b = ncbl_->item(i);
+		for (int j=0; j < b->cnt_; ++j) {
+			netcon_obj(b->nc_ + j);
+		}
+	}
+}
+
+// SaveState and BBSaveState identify NetCon by their hoc objects
+void nrn_netcon_compact_materialize() {
+	net_cvode_instance->netcon_compact_materialize();
 }
 
 void NetCvode::psl_append(PreSyn* ps) {
@@ -4513,6 +4829,7 @@ void NetCvode::presyn_disconnect(PreSyn* ps) {
 	if (ps->hi_th_) {
 		hoc_l_delete(ps->hi_th_);
 		ps->hi_th_ = nil;
+		psl_thr_invalid();
 	}
 	if (ps->thvar_) {
 		--pst_cnt_;
@@ -4571,12 +4888,14 @@ void DiscreteEvent::savestate_write(FILE* f) {
 
 NetCon::NetCon() {
 	cnt_ = 0; obj_ = nil; active_ = false; weight_ = nil;
+	compact_ = false;
 	NetConSave::invalid();
 }
 
 NetCon::NetCon(PreSyn* src, Object* target) {
 	NetConSave::invalid();
 	obj_ = nil;
+	compact_ = false;
 	src_ = src;
 	delay_ = 1.0;
 	if (src_) {
@@ -4613,7 +4932,7 @@ NetCon::~NetCon() {
 //printf("~NetCon\n");
 	NetConSave::invalid();
 	rmsrc();
-	if (cnt_) {
+	if (cnt_ && !compact_) {
 		delete [] weight_;
 	}
 #if DISCRETE_EVENT_OBSERVER
@@ -4775,6 +5094,7 @@ void NetCvode::ps_thread_link(PreSyn* ps) {
 			p[i].psl_thr_ = hoc_l_newlist();
 		}
 		ps->hi_th_ = hoc_l_insertvoid(p[i].psl_thr_, ps);
+		p[i].th_valid_ = false;
 	}
 }
 
@@ -4788,6 +5108,7 @@ void NetCvode::update_ps2nt() {
 		if (p[i].psl_thr_) {
 			hoc_l_freelist(&p[i].psl_thr_);
 		}
+		p[i].th_valid_ = false;
 	}
 	if (psl_) ITERATE(q, psl_) {
 		PreSyn* ps = (PreSyn*)VOIDITM(q);
@@ -4795,6 +5116,53 @@ void NetCvode::update_ps2nt() {
 	}
 }
 
+// The fixed step threshold arrays are a copy of psl_thr_ along with
+// each PreSyn thvar_, threshold_, and flag_. Anything that changes
+// those outside of check_thresh must call this.
+void NetCvode::psl_thr_invalid() {
+	for (int i=0; i < pcnt_; ++i) {
+		p[i].th_valid_ = false;
+	}
+}
+
+void NetCvode::psl_thr_fill(NrnThread* nt) {
+	NetCvodeThreadData& d = p[nt->id];
+	hoc_Item* q;
+	int cnt = 0;
+	ITERATE(q, d.psl_thr_) {
+		++cnt;
+	}
+	if (cnt > d.th_size_) {
+		if (d.th_size_) {
+			delete [] d.th_ps_;
+			delete [] d.th_var_;
+			delete [] d.th_thresh_;
+			delete [] d.th_flag_;
+			delete [] d.th_cross_;
+		}
+		d.th_size_ = cnt;
+		d.th_ps_ = new PreSyn*[cnt];
+		d.th_var_ = new double*[cnt];
+		d.th_thresh_ = new double[cnt];
+		d.th_flag_ = new char[cnt];
+		d.th_cross_ = new int[cnt];
+	}
+	cnt = 0;
+	ITERATE(q, d.psl_thr_) {
+		PreSyn* ps = (PreSyn*)VOIDITM(q);
+		// only the ones for this thread
+		if (ps->nt_ == nt && ps->thvar_) {
+			d.th_ps_[cnt] = ps;
+			d.th_var_[cnt] = ps->thvar_;
+			d.th_thresh_[cnt] = ps->threshold_;
+			d.th_flag_[cnt] = ps->flag_ ? 1 : 0;
+			++cnt;
+		}
+	}
+	d.th_cnt_ = cnt;
+	d.th_valid_ = true;
+}
+
 void NetCvode::p_construct(int n) {
 	int i;
 	if (pcnt_ != n) {
@@ -5471,20 +5839,30 @@ void NetCvode::fixed_play_continuous(NrnThread* nt) {
 // factored this out from deliver_net_events so we can
 // stay in the cache
 void NetCvode::check_thresh(NrnThread* nt) { // for default method
-	int i;
-
-	hoc_Item* pth = p[nt->id].psl_thr_;
-
-	if (pth) { /* only look at ones with a threshold */
-		hoc_Item* q1;
-		ITERATE(q1, pth) {
-			PreSyn* ps = (PreSyn*)VOIDITM(q1);
-		    // only the ones for this thread
-		    if (ps->nt_ == nt) {
-			if (ps->thvar_) {
-				ps->check(nt, nt->_t, 1e-10);
-			}
-		    }
+	int i, n;
+	NetCvodeThreadData& d = p[nt->id];
+
+	if (d.psl_thr_) { /* only look at ones with a threshold */
+		if (!d.th_valid_) {
+			psl_thr_fill(nt);
+		}
+		// one pass over the contiguous arrays collects the
+		// PreSyn whose above/below state changed. Crossings are
+		// rare so the full check is only done for those.
+		double** var = d.th_var_;
+		double* thresh = d.th_thresh_;
+		char* flag = d.th_flag_;
+		int* cross = d.th_cross_;
+		int cnt = d.th_cnt_;
+		n = 0;
+		for (i=0; i < cnt; ++i) {
+			char above = (*var[i] - thresh[i] > 0.0);
+			cross[n] = i;
+			n += (above != flag[i]);
+			flag[i] = above;
+		}
+		for (i=0; i < n; ++i) {
+			d.th_ps_[cross[i]]->check(nt, nt->_t, 1e-10);
 		}
 	}
 	for (i=0; i < wl_list_->count(); ++i) {
@@ -6169,6 +6547,7 @@ void NetCvode::recalc_ptrs() {
 			}
 		}
 	}
+	psl_thr_invalid();
 #endif
 }
 
@@ -6273,7 +6652,9 @@ hoc_execerror("Lvardt method from fadvance()", "presently limited to single thre
 	return err;
 }
 
+// timed here, in the thread that delivers, for deliver_events_when_threads
 static void* deliver_for_thread(NrnThread* nt) {
+	unsigned long long t0;
 	NetCvode* nc = net_cvode_instance;
 	NetCvodeThreadData& d = nc->p[nt->id];
 	TQItem* q = d.tqe_->least();	
@@ -6283,7 +6664,9 @@ static void* deliver_for_thread(NrnThread* nt) {
 #if PRINT_EVENT
 	if (nc->print_event_) { de->pr("deliver", tt, nc); }
 #endif
+	nc->prof_events_begin(nt, t0);
 	de->deliver(tt, nc, nt);
+	nc->prof_events_end(nt, t0);
 	return 0;
 }
 
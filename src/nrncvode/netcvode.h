@@ -11,6 +11,7 @@ class PreSyn;
 class HocDataPaths;
 class PreSynTable;
 class NetCon;
+class NetConBlockList;
 class DiscreteEvent;
 class TQItemPool;
 class SelfEventPool;
@@ -42,6 +43,15 @@ public:
 	Cvode* lcv_; // for lvardt
 	TQueue* tqe_;
 	hoc_Item* psl_thr_; //for presyns with fixed step threshold checking
+	// contiguous copy of psl_thr_ so the fixed step check is one pass
+	int th_cnt_;
+	int th_size_;
+	bool th_valid_;
+	PreSyn** th_ps_;
+	double** th_var_;
+	double* th_thresh_;
+	char* th_flag_;
+	int* th_cross_;
 	SelfEventPool* sepool_;
 	TQItemPool* tpool_;
 	InterThreadEvent* inter_thread_events_;
@@ -52,6 +62,7 @@ public:
 	int ite_size_;
 	int unreffed_event_cnt_;
 	double immediate_deliver_;
+	int prof_depth_; // nesting of event delivery, see prof_events_begin
 };
 
 class NetCvode {
@@ -94,6 +105,8 @@ public:
 	void check_thresh(NrnThread*);
 	void deliver_net_events(NrnThread*); // for default staggered time step method
 	void deliver_events(double til, NrnThread*); // for initialization events
+	void prof_events_begin(NrnThread*, unsigned long long& t0);
+	void prof_events_end(NrnThread*, unsigned long long t0);
 	void solver_prepare();
 	void clear_events();
 	void init_events();
@@ -103,6 +116,13 @@ public:
 	void local_retreat(double, Cvode*);
 	void retreat(double, Cvode*);
 	Object** netconlist();
+	int netcon_compact();
+	int netcon_compact(PreSyn*, int n, Object** targets, double* delay,
+		double* weight, int nw);
+	int netcon_compact_check(Object* target, double delay);
+	void netcon_compact_remove();
+	Object* netcon_obj(NetCon*);
+	void netcon_compact_materialize();
 	int owned_by_thread(double*);
 	PlayRecord* playrec_uses(void*);
 	void playrec_add(PlayRecord*);
@@ -125,6 +145,8 @@ public:
 	void condition_order(int i) { condition_order_ = i; }
 	TQueue* event_queue(NrnThread* nt);
 	void psl_append(PreSyn*);
+	PreSyn* presyn_install(double* psrc, Section* ssrc, Object* osrc,
+		double threshold);
 	void recalc_ptrs();
 public:
 	void rtol(double); double rtol(){return rtol_;}
@@ -184,6 +206,8 @@ public:
 	double maxstate_analyse(Symbol*, double*);
 	void p_construct(int);
 	void ps_thread_link(PreSyn*);
+	void psl_thr_invalid();
+	void psl_thr_fill(NrnThread*);
 	MaxStateTable* mst_;
 private:
 	int maxorder_, jacobian_, stiff_;
@@ -194,6 +218,7 @@ private:
 	bool single_;
 	PreSynTable* pst_;
 	int pst_cnt_;
+	NetConBlockList* ncbl_;
 	int playrec_change_cnt_;
 	PlayRecList* prl_;
 	IvocVect* vec_event_store_;
@@ -550,6 +550,7 @@ int Cvode::solvex_thread(double* b, double* y, NrnThread* nt){
 //printf("\tenter b\n");
 //for (int i=0; i < neq_; ++i) { printf("\t\t%d %g\n", i, b[i]);}
 	int i;
+	unsigned long long t0;
 	CvodeThreadData& z = CTD(nt->id);
 	nt->cj = 1./gam();
 	nt->_dt = gam();
@@ -561,6 +562,7 @@ int Cvode::solvex_thread(double* b, double* y, NrnThread* nt){
 		NODERHS(z.no_cap_node_[i]) = 0.;
 	}
 	// solve it
+	NRN_PROF_BEGIN(t0)
 #if PARANEURON
 	if (nrn_multisplit_solve_) {
 		(*nrn_multisplit_solve_)();
@@ -570,6 +572,7 @@ int Cvode::solvex_thread(double* b, double* y, NrnThread* nt){
 		triang(nt);
 		bksub(nt);
 	}
+	NRN_PROF_END(t0, nt, NRN_PROF_SOLVE, 0)
 //for (i=0; i < v_node_count; ++i) {
 //	printf("%d rhs %d %g t=%g\n", nrnmpi_myid, i, VEC_RHS(i), t);
 //}
@@ -629,11 +632,13 @@ void Cvode::solvemem(NrnThread* nt) {
 	// all the membrane mechanism matrices
 	CvodeThreadData& z = CTD(nt->id);
 	CvMembList* cml;
+	unsigned long long t0;
 	for (cml = z.cv_memb_list_; cml; cml = cml->next) { // probably can start at 6 or hh
 		Memb_func* mf = memb_func + cml->index;
 		if (mf->ode_matsol) {
 			Memb_list* ml = cml->ml;
 			Pfridot s = (Pfridot)mf->ode_matsol;
+			NRN_PROF_BEGIN(t0)
 			if (mf->hoc_mech) {
 				int j, count;
 				count = ml->nodecount;
@@ -644,6 +649,7 @@ void Cvode::solvemem(NrnThread* nt) {
 			}else{
 				(*s)(nt, ml, cml->index);
 			}
+			NRN_PROF_END(t0, nt, NRN_PROF_JACOB, cml->index)
 			if (errno) {
 				if (nrn_errno_check(cml->index)) {
 hoc_warning("errno set during ode jacobian solve", (char*)0);
@@ -894,11 +900,13 @@ void Cvode::do_ode(NrnThread* _nt){
 	CvodeThreadData& z = CTD(_nt->id);
 	CvMembList* cml;
 	Memb_func* mf;
+	unsigned long long t0;
 	for (cml = z.cv_memb_list_; cml; cml = cml->next) { // probably can start at 6 or hh
 		mf = memb_func + cml->index;
 		if (mf->ode_spec) {
 			Pfridot s = (Pfridot)mf->ode_spec;
 			Memb_list* ml = cml->ml;
+			NRN_PROF_BEGIN(t0)
 			if (mf->hoc_mech) {
 				int j, count;
 				count = ml->nodecount;
@@ -909,6 +917,7 @@ void Cvode::do_ode(NrnThread* _nt){
 			}else{
 				(*s)(_nt, ml, cml->index);
 			}
+			NRN_PROF_END(t0, _nt, NRN_PROF_STATE, cml->index)
 			if (errno) {
 				if (nrn_errno_check(cml->index)) {
 hoc_warning("errno set during ode evaluation", (char*)0);
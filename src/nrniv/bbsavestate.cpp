@@ -205,6 +205,8 @@ extern TQueue* net_cvode_instance_event_queue(NrnThread*);
 extern void clear_event_queue();
 extern cTemplate** nrn_pnt_template_;
 extern hoc_Item* net_cvode_instance_psl();
+extern void nrn_psl_thr_invalid();
+extern void nrn_netcon_compact_materialize();
 extern PlayRecList* net_cvode_instance_prl();
 extern void nrn_netcon_event(NetCon*, double);
 extern void net_send(void**, double*, Point_process*, double, double);
@@ -1262,6 +1264,7 @@ printf("%d Have not decided whether to remove this event\n", nrnmpi_myid);
 void BBSaveState::mk_pp2de() {
 	hoc_Item* q;
 	assert(!pp2de); // one only or make it a field.
+	nrn_netcon_compact_materialize();
 	int n = nct->count;
 	pp2de = new PP2DE(n+1);
 	ITERATE(q, nct->olist) {
@@ -2229,6 +2232,7 @@ f->s(buf, 1);
 			int j = (ps->flag_ ? 1 : 0);
 			f->i(j);
 			ps->flag_ = j;
+			nrn_psl_thr_invalid();
 			f->d(1, ps->valthresh_);
 #if 0
 			f->d(1, ps->valold_);
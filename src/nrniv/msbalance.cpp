@@ -0,0 +1,617 @@
+#include <../../nrnconf.h>
+// Choose multisplit split points and rank assignments from segment costs.
+//
+// lb = new MultiSplitBalance()
+// lb.weight("hh", w) cost of a segment with hh, e.g. a measured time.
+//	The default is 1 + number of range variables, ions 0.
+// cost = soma lb.cell(gid) register the tree containing soma.
+//	Every rank must register every cell in the same order.
+// ratio = lb.balance(nhost [, sidbase]) max rank load / mean rank load
+// n = lb.ranks(gid, vec) ranks that own pieces of the cell
+// max = lb.load(vec) cost of each rank
+// n = lb.split(gid, rank) delete the sections of gid not on rank and make
+//	the ParallelContext.multisplit calls for the ones that remain.
+//	Afterwards, after all cells, call pc.multisplit() as usual.
+//
+// A piece is a set of subtrees with at most two split nodes, as required
+// by multisplit. For a given maximum piece cost, a cell is divided top
+// down. A piece may have one split node with all the subtrees at that node
+// moved to other pieces, except the small ones that still fit.
+// Subtrees too large for one piece become backbone pieces which are again
+// split at one more node. The pieces are assigned to ranks with the
+// least processing time rule, and the maximum piece cost that gives the
+// smallest maximum rank load is kept.
+
+#include <stdio.h>
+#include <math.h>
+#include <InterViews/resource.h>
+#include <nrnoc2iv.h>
+#include <nrniv_mf.h>
+#include <classreg.h>
+#include "ivocvect.h"
+#include "parse.h"
+
+#include <vector>
+#include <queue>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+extern "C" {
+extern void nrnmpi_multisplit(double x, int sid, int backbone_style);
+extern int n_memb_func;
+extern int* nrn_prop_param_size_;
+}
+
+// extra cost per backbone node (see LoadBalance.backbone_cx_)
+#define BACKBONE_WEIGHT .6
+
+struct MsbCell {
+	int gid;
+	std::vector<Section*> sec; // depth first from the root
+	std::vector<int> parent; // index into sec, -1 for the root
+	std::vector<int> size; // sections in subtree, sec[i..i+size[i]-1]
+	std::vector<double> cost;
+	std::vector<double> sub; // subtree cost
+	std::vector<double> rem; // subtree cost not yet cut away
+	std::vector<int> piece; // after balance
+	std::vector<int> cutsid; // sid at its parent node if cut there, else -1
+	bool split;
+};
+
+struct MsbSplit {
+	int cell;
+	int owner; // section index that owns the split node
+	double x;
+	int sid;
+};
+
+struct MsbPiece {
+	int cell;
+	double cost;
+	int rank;
+};
+
+class MultiSplitBalance {
+public:
+	MultiSplitBalance();
+	virtual ~MultiSplitBalance();
+	double weight(int type);
+	void weight(int type, double w);
+	double cell(int gid, Section*);
+	double balance(int nhost, int sidbase);
+	int ranks(int gid, Vect*);
+	double load(Vect*);
+	int split(int gid, int rank);
+	int npiece() { return pieces_.size(); }
+private:
+	MsbCell* find(int gid);
+	void chk_balanced();
+	void partition(double cmax);
+	double assign();
+	void part_cell(int ic);
+	double region(int ic, int k, int p, int ncut);
+	int new_piece(int ic);
+	void assign_subtree(MsbCell& c, int k, int from, int to);
+private:
+	std::vector<double> weight_;
+	std::vector<MsbCell*> cells_;
+	std::vector<MsbPiece> pieces_;
+	std::vector<MsbSplit> splits_;
+	std::vector<double> load_;
+	double cmax_;
+	int nhost_;
+	int sidbase_;
+	bool balanced_;
+};
+
+MultiSplitBalance::MultiSplitBalance() {
+	weight_.resize(n_memb_func, -1.);
+	nhost_ = 0;
+	sidbase_ = 0;
+	cmax_ = 0.;
+	balanced_ = false;
+}
+
+MultiSplitBalance::~MultiSplitBalance() {
+	for (size_t i = 0; i < cells_.size(); ++i) {
+		MsbCell* c = cells_[i];
+		for (size_t j = 0; j < c->sec.size(); ++j) {
+			section_unref(c->sec[j]);
+		}
+		delete c;
+	}
+}
+
+double MultiSplitBalance::weight(int type) {
+	if (weight_[type] >= 0.) {
+		return weight_[type];
+	}
+	if (nrn_is_ion(type)) {
+		return 0.;
+	}
+	return 1. + nrn_prop_param_size_[type];
+}
+
+void MultiSplitBalance::weight(int type, double w) {
+	weight_[type] = w;
+	balanced_ = false;
+}
+
+MsbCell* MultiSplitBalance::find(int gid) {
+	for (size_t i = 0; i < cells_.size(); ++i) {
+		if (cells_[i]->gid == gid) {
+			return cells_[i];
+		}
+	}
+	char buf[50];
+	sprintf(buf, "%d", gid);
+	hoc_execerror("MultiSplitBalance has no cell with gid", buf);
+	return NULL;
+}
+
+void MultiSplitBalance::chk_balanced() {
+	if (!balanced_) {
+		hoc_execerror("MultiSplitBalance.balance()", "has not been called");
+	}
+}
+
+double MultiSplitBalance::cell(int gid, Section* sec) {
+	while (sec->parentsec) {
+		sec = sec->parentsec;
+	}
+	for (size_t i = 0; i < cells_.size(); ++i) {
+		if (cells_[i]->gid == gid) {
+			char buf[50];
+			sprintf(buf, "%d", gid);
+			hoc_execerror("MultiSplitBalance already has a cell with gid", buf);
+		}
+	}
+	MsbCell* c = new MsbCell();
+	c->gid = gid;
+	c->split = false;
+	// depth first, children in the order of the sibling list
+	std::vector<std::pair<Section*, int> > stk;
+	stk.push_back(std::pair<Section*, int>(sec, -1));
+	while (!stk.empty()) {
+		Section* s = stk.back().first;
+		int ip = stk.back().second;
+		stk.pop_back();
+		int i = c->sec.size();
+		section_ref(s);
+		c->sec.push_back(s);
+		c->parent.push_back(ip);
+		double cx = 0.;
+		for (int j = 0; j < s->nnode - 1; ++j) {
+			cx += 1.;
+			for (Prop* p = s->pnode[j]->prop; p; p = p->next) {
+				cx += weight(p->type);
+			}
+		}
+		c->cost.push_back(cx);
+		// reverse so the first child is visited first
+		std::vector<Section*> ch;
+		for (Section* s1 = s->child; s1; s1 = s1->sibling) {
+			ch.push_back(s1);
+		}
+		for (int j = ch.size() - 1; j >= 0; --j) {
+			stk.push_back(std::pair<Section*, int>(ch[j], i));
+		}
+	}
+	int n = c->sec.size();
+	c->size.resize(n, 1);
+	c->sub = c->cost;
+	for (int i = n - 1; i > 0; --i) {
+		c->size[c->parent[i]] += c->size[i];
+		c->sub[c->parent[i]] += c->sub[i];
+	}
+	c->piece.resize(n, -1);
+	c->cutsid.resize(n, -1);
+	cells_.push_back(c);
+	balanced_ = false;
+	return c->sub[0];
+}
+
+int MultiSplitBalance::new_piece(int ic) {
+	MsbPiece p;
+	p.cell = ic;
+	p.cost = 0.;
+	p.rank = -1;
+	pieces_.push_back(p);
+	return pieces_.size() - 1;
+}
+
+// sections of subtree k now in piece from go to piece to
+void MultiSplitBalance::assign_subtree(MsbCell& c, int k, int from, int to) {
+	for (int i = k; i < k + c.size[k]; ++i) {
+		if (c.piece[i] == from) {
+			c.piece[i] = to;
+		}
+	}
+}
+
+void MultiSplitBalance::partition(double cmax) {
+	cmax_ = cmax;
+	pieces_.clear();
+	splits_.clear();
+	for (size_t ic = 0; ic < cells_.size(); ++ic) {
+		part_cell(ic);
+	}
+}
+
+void MultiSplitBalance::part_cell(int ic) {
+	MsbCell& c = *cells_[ic];
+	int n = c.sec.size();
+	c.rem = c.sub;
+	for (int i = 0; i < n; ++i) {
+		c.piece[i] = -1;
+		c.cutsid[i] = -1;
+	}
+	int p = new_piece(ic);
+	assign_subtree(c, 0, -1, p);
+	if (c.sub[0] <= cmax_) {
+		pieces_[p].cost = c.sub[0];
+		return;
+	}
+	double cx = region(ic, 0, p, 2); // pieces_ may be reallocated
+	pieces_[p].cost = cx;
+}
+
+// Piece p holds what remains of subtree k. Cut up to ncut nodes so that
+// its cost is at most cmax_ and distribute the subtrees at those nodes.
+// Returns the cost of p.
+double MultiSplitBalance::region(int ic, int k, int p, int ncut) {
+	MsbCell& c = *cells_[ic];
+	double r = c.rem[k];
+	double bb = 0.; // backbone overhead
+	for (int icut = 0; icut < ncut && r > cmax_; ++icut) {
+		// Candidate split nodes are where children of a section in p
+		// attach to that section (not at its 0 end unless it is the
+		// root). Choose the one that leaves the most cost in p
+		// without exceeding cmax_, or else the least.
+		int best = -1;
+		Node* bestnd = NULL;
+		double bestr = 0.;
+		for (int i = k; i < k + c.size[k]; ++i) {
+			if (c.piece[i] != p) { continue; }
+			Section* s = c.sec[i];
+			for (int j = i + 1; j < i + c.size[i]; j += c.size[j]) {
+				// j iterates over the children of i
+				Node* nd = c.sec[j]->parentnode;
+				if (c.piece[j] != p || (i > 0 && nd == s->parentnode)) {
+					continue;
+				}
+				// all the children of i at nd, once per nd
+				double removal = 0.;
+				int j1;
+				for (j1 = i + 1; j1 < j; j1 += c.size[j1]) {
+					if (c.piece[j1] == p && c.sec[j1]->parentnode == nd) {
+						break;
+					}
+				}
+				if (j1 < j) { continue; }
+				for (j1 = j; j1 < i + c.size[i]; j1 += c.size[j1]) {
+					if (c.piece[j1] == p && c.sec[j1]->parentnode == nd) {
+						removal += c.rem[j1];
+					}
+				}
+				double rb = r - removal;
+				bool better;
+				if (best < 0) {
+					better = true;
+				}else if (bestr <= cmax_) {
+					better = (rb <= cmax_ && rb > bestr);
+				}else{
+					better = (rb < bestr);
+				}
+				if (better) {
+					best = i;
+					bestnd = nd;
+					bestr = rb;
+				}
+			}
+		}
+		if (best < 0) {
+			break;
+		}
+		// the subtrees at the split node, largest first
+		std::vector<std::pair<double, int> > kids;
+		for (int j = best + 1; j < best + c.size[best]; j += c.size[j]) {
+			if (c.piece[j] == p && c.sec[j]->parentnode == bestnd) {
+				kids.push_back(std::pair<double, int>(-c.rem[j], j));
+			}
+		}
+		std::sort(kids.begin(), kids.end());
+		// reserve the sid before the kids are split further
+		int sid = sidbase_ + splits_.size();
+		MsbSplit sp;
+		sp.cell = ic;
+		sp.owner = best;
+		sp.x = nrn_arc_position(c.sec[best], bestnd);
+		sp.sid = sid;
+		splits_.push_back(sp);
+		// first fit decreasing with p as the first bin
+		std::vector<int> bin;
+		std::vector<double> fill;
+		bin.push_back(p);
+		fill.push_back(bestr);
+		double removed = 0.;
+		bool cut = false;
+		for (size_t ik = 0; ik < kids.size(); ++ik) {
+			int j = kids[ik].second;
+			double cx = c.rem[j];
+			size_t ib;
+			for (ib = 0; ib < bin.size(); ++ib) {
+				if (fill[ib] + cx <= cmax_) { break; }
+			}
+			if (ib == 0) {
+				fill[0] += cx;
+				continue;
+			}
+			removed += cx;
+			cut = true;
+			c.cutsid[j] = sid;
+			if (cx > cmax_) {
+				int q = new_piece(ic);
+				assign_subtree(c, j, p, q);
+				double cq = region(ic, j, q, 1);
+				pieces_[q].cost = cq;
+			}else{
+				if (ib == bin.size()) {
+					bin.push_back(new_piece(ic));
+					fill.push_back(0.);
+				}
+				assign_subtree(c, j, p, bin[ib]);
+				fill[ib] += cx;
+			}
+		}
+		for (size_t ib = 1; ib < bin.size(); ++ib) {
+			pieces_[bin[ib]].cost = fill[ib];
+		}
+		if (!cut) {
+			// everything fit back into p
+			splits_.pop_back();
+			r = fill[0];
+			continue;
+		}
+		for (int i = best; i >= k; i = c.parent[i]) {
+			c.rem[i] -= removed;
+			if (i == k) { break; }
+		}
+		r = c.rem[k];
+		if (k > 0) {
+			// a backbone from the parent node of k to the split node
+			for (int i = best; ; i = c.parent[i]) {
+				bb += BACKBONE_WEIGHT * c.sec[i]->nnode;
+				if (i == k) { break; }
+			}
+		}
+	}
+	return r + bb;
+}
+
+// least processing time. Returns the maximum rank load.
+double MultiSplitBalance::assign() {
+	std::vector<std::pair<double, int> > order;
+	for (size_t i = 0; i < pieces_.size(); ++i) {
+		order.push_back(std::pair<double, int>(-pieces_[i].cost, i));
+	}
+	std::sort(order.begin(), order.end());
+	typedef std::pair<double, int> LoadRank;
+	std::priority_queue<LoadRank, std::vector<LoadRank>,
+		std::greater<LoadRank> > heap;
+	load_.assign(nhost_, 0.);
+	for (int i = 0; i < nhost_; ++i) {
+		heap.push(LoadRank(0., i));
+	}
+	for (size_t i = 0; i < order.size(); ++i) {
+		MsbPiece& p = pieces_[order[i].second];
+		LoadRank lr = heap.top();
+		heap.pop();
+		p.rank = lr.second;
+		load_[lr.second] += p.cost;
+		heap.push(LoadRank(load_[lr.second], lr.second));
+	}
+	double mx = 0.;
+	for (int i = 0; i < nhost_; ++i) {
+		if (load_[i] > mx) { mx = load_[i]; }
+	}
+	return mx;
+}
+
+double MultiSplitBalance::balance(int nhost, int sidbase) {
+	nhost_ = nhost;
+	sidbase_ = sidbase;
+	double total = 0.;
+	for (size_t i = 0; i < cells_.size(); ++i) {
+		total += cells_[i]->sub[0];
+	}
+	double mean = total / nhost;
+	// candidate maximum piece costs. The first is no splitting.
+	double f[] = {0., 1., .75, .5, .35, .25};
+	int nf = sizeof(f) / sizeof(double);
+	double bestc = total + 1.;
+	double bestmx = 0.;
+	for (int i = 0; i < nf; ++i) {
+		double cmax = f[i] ? f[i] * mean : total + 1.;
+		partition(cmax);
+		double mx = assign();
+		if (i == 0 || mx < bestmx * (1. - 1e-9)) {
+			bestmx = mx;
+			bestc = cmax;
+		}
+	}
+	partition(bestc);
+	bestmx = assign();
+	balanced_ = true;
+	return mean > 0. ? bestmx / mean : 1.;
+}
+
+int MultiSplitBalance::ranks(int gid, Vect* v) {
+	chk_balanced();
+	MsbCell* c = find(gid);
+	int ic = std::find(cells_.begin(), cells_.end(), c) - cells_.begin();
+	std::vector<int> r;
+	for (size_t i = 0; i < pieces_.size(); ++i) {
+		if (pieces_[i].cell == ic) {
+			r.push_back(pieces_[i].rank);
+		}
+	}
+	std::sort(r.begin(), r.end());
+	r.erase(std::unique(r.begin(), r.end()), r.end());
+	if (v) {
+		v->resize(r.size());
+		for (size_t i = 0; i < r.size(); ++i) {
+			v->elem(i) = r[i];
+		}
+	}
+	return r.size();
+}
+
+double MultiSplitBalance::load(Vect* v) {
+	chk_balanced();
+	double mx = 0.;
+	if (v) {
+		v->resize(nhost_);
+	}
+	for (int i = 0; i < nhost_; ++i) {
+		if (v) {
+			v->elem(i) = load_[i];
+		}
+		if (load_[i] > mx) { mx = load_[i]; }
+	}
+	return mx;
+}
+
+int MultiSplitBalance::split(int gid, int rank) {
+	chk_balanced();
+	MsbCell* c = find(gid);
+	if (c->split) {
+		char buf[50];
+		sprintf(buf, "%d", gid);
+		hoc_execerror("MultiSplitBalance.split already done for gid", buf);
+	}
+	c->split = true;
+	int i, n = c->sec.size();
+	std::vector<bool> keep(n);
+	for (i = 0; i < n; ++i) {
+		keep[i] = pieces_[c->piece[i]].rank == rank;
+	}
+	// Delete first. That disconnects kept children of deleted sections
+	// and leaves the multisplit nodes on the remaining trees.
+	for (i = 0; i < n; ++i) {
+		Section* sec = c->sec[i];
+		if (!keep[i] && sec->prop) {
+			nrn_delete_section(sec);
+		}
+	}
+	for (i = 1; i < n; ++i) {
+		if (keep[i] && c->cutsid[i] >= 0) {
+			nrn_disconnect(c->sec[i]);
+		}
+	}
+	int ic = std::find(cells_.begin(), cells_.end(), c) - cells_.begin();
+	for (size_t j = 0; j < splits_.size(); ++j) {
+		MsbSplit& sp = splits_[j];
+		if (sp.cell != ic) { continue; }
+		if (keep[sp.owner]) {
+			nrn_pushsec(c->sec[sp.owner]);
+			nrnmpi_multisplit(sp.x, sp.sid, 2);
+			nrn_popsec();
+		}
+	}
+	for (i = 1; i < n; ++i) {
+		if (keep[i] && c->cutsid[i] >= 0) {
+			Section* sec = c->sec[i];
+			nrn_pushsec(sec);
+			nrnmpi_multisplit(nrn_arc_position(sec, sec->parentnode),
+				c->cutsid[i], 2);
+			nrn_popsec();
+		}
+	}
+	std::vector<int> pcs;
+	for (i = 0; i < n; ++i) {
+		if (keep[i]) {
+			pcs.push_back(c->piece[i]);
+		}
+	}
+	std::sort(pcs.begin(), pcs.end());
+	return std::unique(pcs.begin(), pcs.end()) - pcs.begin();
+}
+
+static int mechtype_arg(int i) {
+	char* name = gargstr(i);
+	Symbol* s = hoc_lookup(name);
+	if (s && s->type == TEMPLATE) {
+		s = hoc_table_lookup(name, s->u.ctemplate->symtable);
+	}
+	if (!s || s->type != MECHANISM) {
+		hoc_execerror(name, "is not a mechanism");
+	}
+	return s->subtype;
+}
+
+static double msb_weight(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	int type = mechtype_arg(1);
+	double w = lb->weight(type);
+	if (ifarg(2)) {
+		lb->weight(type, chkarg(2, 0., 1e99));
+	}
+	return w;
+}
+
+static double msb_cell(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	return lb->cell((int)chkarg(1, 0, 2e9), chk_access());
+}
+
+static double msb_balance(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	int nhost = (int)chkarg(1, 1, 1e9);
+	int sidbase = ifarg(2) ? (int)chkarg(2, 0, 2e9) : 0;
+	return lb->balance(nhost, sidbase);
+}
+
+static double msb_ranks(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	return lb->ranks((int)chkarg(1, 0, 2e9), ifarg(2) ? vector_arg(2) : NULL);
+}
+
+static double msb_load(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	return lb->load(ifarg(1) ? vector_arg(1) : NULL);
+}
+
+static double msb_split(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	return lb->split((int)chkarg(1, 0, 2e9), (int)chkarg(2, 0, 1e9));
+}
+
+static double msb_npiece(void* v) {
+	MultiSplitBalance* lb = (MultiSplitBalance*)v;
+	return lb->npiece();
+}
+
+static Member_func members[] = {
+	"weight", msb_weight,
+	"cell", msb_cell,
+	"balance", msb_balance,
+	"ranks", msb_ranks,
+	"load", msb_load,
+	"split", msb_split,
+	"npiece", msb_npiece,
+	0, 0
+};
+
+static void* cons(Object*) {
+	return (void*)new MultiSplitBalance();
+}
+
+static void destruct(void* v) {
+	delete (MultiSplitBalance*)v;
+}
+
+void MultiSplitBalance_reg() {
+	class2oc("MultiSplitBalance", cons, destruct, members, NULL, NULL, NULL);
+}
@@ -355,6 +355,9 @@ MultiSplitThread::MultiSplitThread() {
 	backAindex_ = 0;
 	backBindex_ = 0;
 	i1 = i2 = i3 = 0;
+	nindep_ = ndep_ = 0;
+	indep_ = dep_ = 0;
+	indep_done_ = false;
 }
 
 MultiSplitThread::~MultiSplitThread() {
@@ -439,6 +442,12 @@ void MultiSplitThread::del_sidA() {
 		delete [] backBindex_;
 		nbackrt_ = 0;
 	}
+	if (indep_) {
+		delete [] indep_;
+		delete [] dep_;
+		indep_ = dep_ = 0;
+		nindep_ = ndep_ = 0;
+	}
 }
 
 void MultiSplitControl::del_msti() {
@@ -1236,7 +1245,7 @@ for (i=0; i < nt; ++i) {
 		delete [] od;
 		delete [] iod;
 		ix = m.nd_rt_index_ + m.nnode_rt_;
-		ixth = m.nd_rt_index_th_;
+		ixth = m.nd_rt_index_th_ + m.nnode_rt_;
 		od = m.offdiag_ + m.nnode_rt_;
 		iod = m.ioffdiag_ + m.nnode_rt_;
 	}else{
@@ -1842,9 +1851,7 @@ void* nrn_multisplit_triang(NrnThread* nt){
 	return (void*)0;
 }
 void* nrn_multisplit_reduce_solve(NrnThread* nt){
-	if (nt->id == 0) {
-		msc_->reduce_solve();
-	}
+	msc_->reduce_solve(nt);
 	return (void*)0;
 }
 void* nrn_multisplit_bksub(NrnThread* nt){
@@ -1876,12 +1883,46 @@ void MultiSplitThread::triang(NrnThread* _nt) {
 	triang_subtree2backbone(_nt);
 	triang_backbone(_nt);
 }
-void MultiSplitControl::reduce_solve() {
-	matrix_exchange();
+// Called by every thread. Thread 0 does the exchange. Meanwhile the other
+// threads back substitute their cells that have no sid and, if the
+// threads run concurrently, share the reduced tree solves with thread 0.
+void MultiSplitControl::reduce_solve(NrnThread* nt) {
+	int i, id = nt->id;
+	if (id) {
+		MultiSplitThread& t = mth_[id];
+		t.bksub_nodes(nt, t.nindep_, t.indep_);
+		t.indep_done_ = true;
+	}
+	if (!nrn_thread_publish_active()) {
+		if (id == 0) {
+			matrix_exchange();
+		}
+		return;
+	}
+	if (id == 0) {
+		matrix_exchange_part1();
+		nrn_thread_publish(nt);
+	}else{
+		nrn_thread_await(0);
+	}
+	rtree_solve(id, nrn_nthread);
+	if (id == 0) {
+		for (i = 1; i < nrn_nthread; ++i) {
+			nrn_thread_await(i);
+		}
+		matrix_exchange_part2();
+	}else{
+		nrn_thread_publish(nt);
+	}
 }
 void MultiSplitThread::bksub(NrnThread* _nt) {
 	bksub_backbone(_nt);
-	bksub_subtrees(_nt);
+	if (indep_done_) {
+		indep_done_ = false;
+		bksub_nodes(_nt, ndep_, dep_);
+	}else{
+		bksub_subtrees(_nt);
+	}
 }
 
 // In the typical case, all nodes connected to the same sids have 0 area
@@ -2012,11 +2053,17 @@ void MultiSplitControl::multisplit_adjust_rhs(NrnThread* _nt) {
 // short -> long  ihost_short_long, nthost_
 
 void MultiSplitControl::matrix_exchange() {
+	matrix_exchange_part1();
+	rtree_solve(0, 1);
+	matrix_exchange_part2();
+}
+
+// everything up to the reduced tree solves. Fills the reduced trees.
+void MultiSplitControl::matrix_exchange_part1() {
 	int i, j, jj, k;
 	double* tbuf;
-	double rttime;
-	double wt = nrnmpi_wtime();
 	NrnThread* _nt;
+	exchange_wt_ = nrnmpi_wtime();
 	// the mpi strategy is copied from the
 	// cvode/examples_par/pvkxb.c exchange strategy
 
@@ -2129,7 +2176,7 @@ for (i=0; i < tbsize_; ++i) { printf("%d trecvbuf[%d] = %g\n", nrnmpi_myid, i, t
 #endif
 
 	// measure reducedtree,short backbone computation time
-	rttime = nrnmpi_wtime();
+	rttime_ = nrnmpi_wtime();
 
 	// adjust area in place for any D, RHS, sid1A, sid1B on this host
 	// going to ReducedTree on this host
@@ -2143,14 +2190,23 @@ for (i=0; i < tbsize_; ++i) { printf("%d trecvbuf[%d] = %g\n", nrnmpi_myid, i, t
 		}
 	}
 #endif //EXCHANGE_ON
+}
 
-	for (i = 0; i < nrtree_; ++i) {
+// The reduced trees are independent. Thread ith of nth solves every nth.
+void MultiSplitControl::rtree_solve(int ith, int nth) {
+	for (int i = ith; i < nrtree_; i += nth) {
 		rtree_[i]->solve();
 	}
+}
 
+// send the reduced tree results and add what is received to the matrix
+void MultiSplitControl::matrix_exchange_part2() {
+	int i, j, jj, k;
+	double* tbuf;
+	NrnThread* _nt;
 #if EXCHANGE_ON
 	// measure reducedtree,short backbone computation time
-	nrnmpi_rtcomp_time_ += nrnmpi_wtime() - rttime;
+	nrnmpi_rtcomp_time_ += nrnmpi_wtime() - rttime_;
 
 	// send reduced and short backbone info (reduced -> long, short -> long)
 	for (i=ihost_reduced_long_; i < nthost_; ++i) {
@@ -2213,7 +2269,7 @@ nrnmpi_myid, mt.host_, 2*j, tbuf[2*j], 2*j+1, tbuf[2*j+1], mt.nodeindex_[j]);
 #endif //EXCHANGE_ON
 
 #if PARANEURON
-	nrnmpi_splitcell_wait_ += nrnmpi_wtime() - wt;
+	nrnmpi_splitcell_wait_ += nrnmpi_wtime() - exchange_wt_;
 #endif
 	errno = 0;
 }
@@ -2916,6 +2972,20 @@ for (i=i1; i < backbone_end; ++i) {
 #endif
 }
 
+// bksub_subtrees restricted to the ix list (see indep_setup)
+void MultiSplitThread::bksub_nodes(NrnThread* _nt, int n, int* ix) {
+	int i, k, ip;
+	for (k = 0; k < n && (i = ix[k]) < backbone_begin; ++k) {
+		RHS(i) /= D(i);
+	}
+	for (; k < n; ++k) {
+		i = ix[k];
+		ip = _nt->_v_parent_index[i];
+		RHS(i) -= B(i) * RHS(ip);
+		RHS(i) /= D(i);
+	}
+}
+
 // fill the v_node, v_parent node vectors in the proper order and
 // determine backbone index values. See the NOTE above. The relevant order
 // is:
@@ -3283,6 +3353,50 @@ printf("i=%d parent=%d\n", i, nt->_v_parent[i]->v_node_index);
 	}
 	// sid1A, sid1B pointers in reducedtree map will be updated by
 	// rt_map_update along with d and rhs
+	indep_setup(nt);
+}
+
+// Divide the nodes outside the backbones into those whose tree has no
+// sid and the rest. Both lists are in node order.
+void MultiSplitThread::indep_setup(NrnThread* nt) {
+	int i, j, nnode = i3 - i1;
+	char* dep = new char[nnode];
+	for (i = i1; i < i3; ++i) {
+		dep[i - i1] = (i >= backbone_begin && i < backbone_end);
+	}
+	MultiSplitList* msl = msc_->multisplit_list_;
+	for (i = 0; i < msl->count(); ++i) {
+		MultiSplit* ms = msl->item(i);
+		for (j = 0; j < 2; ++j) {
+			Node* nd = ms->nd[j];
+			if (nd && nd->_nt == nt) {
+				dep[nd->v_node_index - i1] = 1;
+			}
+		}
+	}
+	nindep_ = ndep_ = 0;
+	for (i = i1; i < i3; ++i) {
+		Node* p = nt->_v_parent[i];
+		if (p && dep[p->v_node_index - i1]) {
+			dep[i - i1] = 1;
+		}
+		if (i < backbone_begin || i >= backbone_end) {
+			if (dep[i - i1]) { ++ndep_; } else { ++nindep_; }
+		}
+	}
+	indep_ = new int[nindep_ + 1];
+	dep_ = new int[ndep_ + 1];
+	nindep_ = ndep_ = 0;
+	for (i = i1; i < i3; ++i) {
+		if (i < backbone_begin || i >= backbone_end) {
+			if (dep[i - i1]) {
+				dep_[ndep_++] = i;
+			}else{
+				indep_[nindep_++] = i;
+			}
+		}
+	}
+	delete [] dep;
 }
 
 void MultiSplitControl::pmat(bool full) {
@@ -14,7 +14,9 @@ public:
 	void bksub_backbone(NrnThread*);
 	void bksub_short_backbone_part1(NrnThread*);
 	void bksub_subtrees(NrnThread*);
+	void bksub_nodes(NrnThread*, int n, int* ix);
 	void v_setup(NrnThread*);
+	void indep_setup(NrnThread*);
 
 	double *sid1A, *sid1B; // to be filled in sid1 and sid0 columns
 	int* sid0i; // interior node to sid0 index. parallel to sid1B
@@ -26,6 +28,13 @@ public:
 	int backbone_begin, backbone_long_begin, backbone_interior_begin;
 	int backbone_sid1_begin, backbone_long_sid1_begin, backbone_end;
 	int i1, i2, i3;
+	// nodes outside the backbones, in order, split by whether their
+	// tree has a sid. The independent ones can be back substituted
+	// while the reduced trees are solved.
+	int nindep_, ndep_;
+	int* indep_;
+	int* dep_;
+	bool indep_done_;
 };
 
 class MultiSplitControl {
@@ -40,12 +49,15 @@ public:
 	void multisplit_nocap_v_part3(NrnThread*);
 	void multisplit_adjust_rhs(NrnThread*);
 	void prstruct();
-	void reduce_solve();
+	void reduce_solve(NrnThread*);
 
 	void multisplit(double, int, int);
 	void solve();
 	void reduced_mark(int, int, int, int*, int*, int*);
 	void matrix_exchange();
+	void matrix_exchange_part1();
+	void matrix_exchange_part2();
+	void rtree_solve(int ith, int nth);
 	void matrix_exchange_nocap();
 	void v_setup();
 	void exchange_setup();
@@ -77,6 +89,8 @@ public:
 
 	int nrtree_;
 	ReducedTree** rtree_;
+	double exchange_wt_; // start of matrix_exchange
+	double rttime_; // start of reduced tree computation
 
 	MultiSplitTable* classical_root_to_multisplit_;
 	MultiSplitList* multisplit_list_; // NrnHashIterate is not in insertion order
@@ -23,6 +23,7 @@ declareNrnHash(Gid2PreSyn, int, PreSyn*)
 implementNrnHash(Gid2PreSyn, int, PreSyn*)
 
 #include <errno.h>
+#include <algorithm>
 #include <netcon.h>
 #include <cvodeobj.h>
 #include <netcvode.h>
@@ -48,6 +49,8 @@ extern int nrn_use_selfqueue_;
 extern void nrn_pending_selfqueue(double, NrnThread*);
 extern int vector_capacity(IvocVect*); //ivocvect.h conflicts with STL
 extern double* vector_vec(IvocVect*);
+extern int ivoc_list_count(Object*);
+extern Object* ivoc_list_item(Object*, int);
 extern Object* nrn_sec2cell(Section*);
 extern void ncs2nrn_integrate(double tstop);
 extern void nrn_fake_fire(int gid, double firetime, int fake_out);
@@ -1046,6 +1049,7 @@ double BBS::threshold() {
 	assert(ps);
 	if (ifarg(2)) {
 		ps->threshold_ = *getarg(2);
+		net_cvode_instance->psl_thr_invalid();
 	}
 	return ps->threshold_;
 }
@@ -1147,12 +1151,9 @@ Object** BBS::gid2cell(int gid) {
 	return hoc_temp_objptr(cell);
 }
 
-Object** BBS::gid_connect(int gid) {
-	Object* target = *hoc_objgetarg(2);
-	if (!is_point_process(target)) {
-		hoc_execerror("arg 2 must be a point process", 0);
-	}
-	alloc_space();
+// the PreSyn for the source gid, a new input stub if the gid is not on
+// this machine and not already connected to.
+static PreSyn* gid_connect_presyn(int gid) {
 	PreSyn* ps;
 	if (gid2out_->find(gid, ps)) {
 		// the gid is owned by this machine so connect directly
@@ -1175,6 +1176,16 @@ Object** BBS::gid_connect(int gid) {
 #endif
 		ps->gid_ = gid;
 	}
+	return ps;
+}
+
+Object** BBS::gid_connect(int gid) {
+	Object* target = *hoc_objgetarg(2);
+	if (!is_point_process(target)) {
+		hoc_execerror("arg 2 must be a point process", 0);
+	}
+	alloc_space();
+	PreSyn* ps = gid_connect_presyn(gid);
 	NetCon* nc;
 	Object** po;
 	if (ifarg(3)) {
@@ -1195,6 +1206,81 @@ Object** BBS::gid_connect(int gid) {
 	return po;
 }
 
+// connections ordered by source gid, original order within a gid
+struct GidConnectOrder {
+	GidConnectOrder(double* gid) : gid_(gid) {}
+	bool operator()(int i, int j) const { return gid_[i] < gid_[j]; }
+	double* gid_;
+};
+
+// Connects srcgid[i] to targetlist.object(tarindex[i]) with weight[i]
+// and delay[i] for all i. Instead of a NetCon hoc object per connection,
+// the connections from each source gid are one compact NetCon block
+// (see NetCvode::netcon_compact). All the arguments are checked before
+// anything is created.
+int BBS::gid_connect_bulk(IvocVect* srcgid, Object* targetlist,
+	IvocVect* tarindex, IvocVect* weight, IvocVect* delay
+    ) {
+	int i, j, k, n, ntar;
+	n = vector_capacity(srcgid);
+	if (vector_capacity(tarindex) != n || vector_capacity(weight) != n
+	    || vector_capacity(delay) != n) {
+hoc_execerror("gid_connect_bulk: the Vector arguments must have the same size", 0);
+	}
+	if (n == 0) {
+		return 0;
+	}
+	double* sg = vector_vec(srcgid);
+	double* ti = vector_vec(tarindex);
+	double* dl = vector_vec(delay);
+	ntar = ivoc_list_count(targetlist);
+	alloc_space();
+	// everything that can raise an error is checked before anything
+	// is allocated or connected
+	for (i=0; i < n; ++i) {
+		PreSyn* ps;
+		if (sg[i] < 0 || sg[i] >= MD) {
+			hoc_execerror("gid_connect_bulk: source gid out of range", 0);
+		}
+		if (ti[i] < 0 || ti[i] >= ntar) {
+			hoc_execerror("gid_connect_bulk: target index out of range", 0);
+		}
+		if (gid2out_->find(int(sg[i]), ps) && !ps) {
+			char buf[100];
+			sprintf(buf, "gid %d owned by %d but no associated cell", int(sg[i]), nrnmpi_myid);
+			hoc_execerror(buf, 0);
+		}
+		net_cvode_instance->netcon_compact_check(
+			ivoc_list_item(targetlist, int(ti[i])), dl[i]);
+	}
+	int* order = new int[n];
+	for (i=0; i < n; ++i) {
+		order[i] = i;
+	}
+	std::stable_sort(order, order + n, GidConnectOrder(sg));
+	Object** targets = new Object*[n];
+	double* w = new double[n];
+	double* del = new double[n];
+	for (i=0; i < n; ++i) {
+		k = order[i];
+		targets[i] = ivoc_list_item(targetlist, int(ti[k]));
+		w[i] = vector_vec(weight)[k];
+		del[i] = dl[k];
+	}
+	for (i=0; i < n; i = j) {
+		int gid = int(sg[order[i]]);
+		for (j = i + 1; j < n && int(sg[order[j]]) == gid; ++j) {}
+		PreSyn* ps = gid_connect_presyn(gid);
+		net_cvode_instance->netcon_compact(ps, j - i, targets + i,
+			del + i, w + i, j - i);
+	}
+	delete [] order;
+	delete [] targets;
+	delete [] w;
+	delete [] del;
+	return n;
+}
+
 static int timeout_ = 20;
 int nrn_set_timeout(int timeout) {
 	int tt;
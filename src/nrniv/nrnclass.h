@@ -11,6 +11,7 @@
 	,LinearMechanism_reg()
 	,KSChan_reg()
 	,Impedance_reg()
+	,MultiSplitBalance_reg()
 	,SaveState_reg()
 	,BBSaveState_reg()
 	,FInitializeHandler_reg()
@@ -50,6 +51,7 @@
 	,LinearMechanism_reg
 	,KSChan_reg
 	,Impedance_reg
+	,MultiSplitBalance_reg
 	,SaveState_reg
 	,BBSaveState_reg
 	,FInitializeHandler_reg
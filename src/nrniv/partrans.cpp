@@ -41,6 +41,7 @@ void nrn_partrans_clear();
 static void mpi_transfer();
 static void thread_transfer(NrnThread*);
 static void thread_vi_compute(NrnThread*);
+static void thread_outsrc_pack(NrnThread*);
 static void mk_ttd();
 extern double t;
 extern int v_structure_change;
@@ -121,6 +122,7 @@ file.
 #if 1 || PARANEURON
 extern void (*nrnthread_v_transfer_)(NrnThread*); // before nonvint and BEFORE INITIAL
 extern void (*nrnthread_vi_compute_)(NrnThread*);
+extern void (*nrnthread_v_pack_)(NrnThread*); // after update. before nrnmpi_v_transfer
 extern void (*nrnmpi_v_transfer_)(); // before nrnthread_v_transfer and after update. Called by thread 0.
 extern void (*nrn_mk_transfer_thread_data_)();
 #endif
@@ -132,6 +134,9 @@ extern int nrnmpi_int_allmax(int);
 extern void sgid_alltoallv(sgid_t*, int*, int*, sgid_t*, int*, int*);
 extern void nrnmpi_int_alltoallv(int*, int*, int*,  int*, int*, int*);
 extern void nrnmpi_dbl_alltoallv(double*, int*, int*,  double*, int*, int*);
+extern void nrnmpi_postrecv_doubles(double*, int, int, int, void**);
+extern void nrnmpi_send_doubles(double*, int, int, int);
+extern void nrnmpi_wait(void**);
 #endif
 }
 
@@ -139,6 +144,8 @@ struct TransferThreadData {
 	int cnt;
 	double** tv; // pointers to the ParallelContext.target_var
 	double** sv; // pointers to the ParallelContext.source_var (or into MPI target buffer)
+	int nsrc_tid; // other threads that own sources of these targets
+	int* src_tid; // thread_transfer awaits them if they publish
 };
 static TransferThreadData* transfer_thread_data_;
 static int n_transfer_thread_data_;
@@ -152,6 +159,17 @@ struct SourceViBuf {
 static SourceViBuf* source_vi_buf_;
 static int n_source_vi_buf_;
 
+// For the fixed step method, each thread copies the source values it owns
+// into outsrc_buf_ at the end of update so that mpi_transfer, executed
+// by thread 0, only does the interprocessor exchange.
+struct OutsrcThreadData {
+	int cnt;
+	int* ix; // ascending indices into outsrc_buf_ and poutsrc_
+};
+static OutsrcThreadData* outsrc_thread_data_;
+static int n_outsrc_thread_data_;
+static int outsrc_packed_; // outsrc_buf_ filled since last mpi_transfer
+
 void nrn_partrans_update_ptrs();
 
 declareNrnHash(MapSgid2Int, sgid_t, int);
@@ -175,6 +193,13 @@ static double** poutsrc_; // prior to mpi copy src value to proper place in outs
 static int* poutsrc_indices_; // for recalc pointers
 static int insrc_buf_size_, *insrccnt_, *insrcdspl_;
 static int outsrc_buf_size_, *outsrccnt_, *outsrcdspl_;
+// pc.setup_transfer(1) exchanges only with the ranks that share sources
+// with this rank, using point to point messages instead of alltoallv.
+static int transfer_neighbor_;
+static int n_insrc_rank_, *insrc_rank_; // ranks with insrccnt_ > 0
+static int n_outsrc_rank_, *outsrc_rank_; // ranks with outsrccnt_ > 0
+static void** insrc_request_; // MPI_Request for each insrc_rank_
+#define PARTRANS_TAG 5 // multisplit uses tags 1-4
 static MapSgid2Int* sid2insrc_; // received interprocessor sid data is
 // associated with which insrc_buf index. Created by nrnmpi_setup_transfer
 // and used by mk_ttd
@@ -376,6 +401,9 @@ static void rm_ttd() {
 			delete [] ttd.tv;
 			delete [] ttd.sv;
 		}
+		if (ttd.nsrc_tid) {
+			delete [] ttd.src_tid;
+		}
 	}
 	delete [] transfer_thread_data_;
 	transfer_thread_data_ = 0;
@@ -398,6 +426,56 @@ static void rm_svibuf() {
 	nrnthread_vi_compute_ = 0;
 }
 
+static void rm_otd() {
+	if (!outsrc_thread_data_){ return; }
+	for (int i=0; i < n_outsrc_thread_data_; ++ i) {
+		OutsrcThreadData& otd = outsrc_thread_data_[i];
+		if (otd.cnt) {
+			delete [] otd.ix;
+		}
+	}
+	delete [] outsrc_thread_data_;
+	outsrc_thread_data_ = 0;
+	n_outsrc_thread_data_ = 0;
+	outsrc_packed_ = 0;
+	nrnthread_v_pack_ = 0;
+}
+
+static void mk_otd() {
+	int i, tid;
+	rm_otd();
+	if (outsrc_buf_size_ == 0 || nrnmpi_v_transfer_ != mpi_transfer) {
+		return;
+	}
+	outsrc_thread_data_ = new OutsrcThreadData[nrn_nthread];
+	n_outsrc_thread_data_ = nrn_nthread;
+	for (tid = 0; tid < nrn_nthread; ++tid) {
+		outsrc_thread_data_[tid].cnt = 0;
+	}
+	// count
+	for (i=0; i < outsrc_buf_size_; ++i) {
+		Node* nd = visources_->item(poutsrc_indices_[i]);
+		tid = nd->_nt ? nd->_nt->id : 0;
+		++outsrc_thread_data_[tid].cnt;
+	}
+	// allocate
+	for (tid = 0; tid < nrn_nthread; ++tid) {
+		OutsrcThreadData& otd = outsrc_thread_data_[tid];
+		if (otd.cnt) {
+			otd.ix = new int[otd.cnt];
+		}
+		otd.cnt = 0; // recount on fill
+	}
+	// fill
+	for (i=0; i < outsrc_buf_size_; ++i) {
+		Node* nd = visources_->item(poutsrc_indices_[i]);
+		tid = nd->_nt ? nd->_nt->id : 0;
+		OutsrcThreadData& otd = outsrc_thread_data_[tid];
+		otd.ix[otd.cnt++] = i;
+	}
+	nrnthread_v_pack_ = thread_outsrc_pack;
+}
+
 static MapNode2PDbl* mk_svibuf() {
 	rm_svibuf();
 	if (!visources_ || visources_->count() == 0) { return NULL; }
@@ -476,9 +554,47 @@ static MapNode2PDbl* mk_svibuf() {
 	return ndvi2pd;
 }
 
+static void mk_ttd_src_tid() {
+	// For each thread, the other threads whose source values it reads.
+	int i, tid, stid, k;
+	int* seen = new int[nrn_nthread];
+	int* ids = new int[nrn_nthread];
+	for (tid = 0; tid < nrn_nthread; ++tid) {
+		seen[tid] = -1;
+	}
+	for (tid = 0; tid < nrn_nthread; ++tid) {
+		TransferThreadData& ttd = transfer_thread_data_[tid];
+		int n = 0;
+		for (i = 0; i < targets_->count(); ++i) {
+			if (((NrnThread*)target_pntlist_->item(i)->_vnt)->id != tid) {
+				continue;
+			}
+			if (!sgid2srcindex_->find(sgid2targets_->item(i), k)) {
+				continue; // from insrc_buf_
+			}
+			Node* nd = visources_->item(k);
+			stid = nd->_nt ? nd->_nt->id : 0;
+			if (stid != tid && seen[stid] != tid) {
+				seen[stid] = tid;
+				ids[n++] = stid;
+			}
+		}
+		if (n) {
+			ttd.nsrc_tid = n;
+			ttd.src_tid = new int[n];
+			for (i = 0; i < n; ++i) {
+				ttd.src_tid[i] = ids[i];
+			}
+		}
+	}
+	delete [] seen;
+	delete [] ids;
+}
+
 static void mk_ttd() {
 	int i, j, k, tid, n;
 	MapNode2PDbl* ndvi2pd = mk_svibuf();
+	mk_otd();
 	rm_ttd();
 	if (!targets_ || targets_->count() == 0) {
 		if (ndvi2pd) { delete ndvi2pd; }
@@ -507,6 +623,7 @@ hoc_execerror("For multiple threads, the target pointer must reference a range v
 	transfer_thread_data_ = new TransferThreadData[nrn_nthread];
 	for (tid = 0; tid < nrn_nthread; ++tid) {
 		transfer_thread_data_[tid].cnt = 0;
+		transfer_thread_data_[tid].nsrc_tid = 0;
 	}
 	n_transfer_thread_data_ = nrn_nthread;
 	// how many targets in each thread
@@ -562,6 +679,9 @@ fprintf(stderr, "No source_var for target_var sid = %lld\n", (long long)sid);
 		}
 	}
 	if (ndvi2pd) { delete ndvi2pd; }
+	if (nrn_nthread > 1) {
+		mk_ttd_src_tid();
+	}
 	nrnthread_v_transfer_ = thread_transfer;
 }
 
@@ -579,16 +699,86 @@ void thread_vi_compute(NrnThread* _nt) {
 	}
 }
 
+void thread_outsrc_pack(NrnThread* _nt) {
+	// source values this thread owns that are needed by mpi_transfer.
+	// Relevant poutsrc_ point into the SourceViBuf so this must follow
+	// thread_vi_compute.
+	assert(n_outsrc_thread_data_ == nrn_nthread);
+	OutsrcThreadData& otd = outsrc_thread_data_[_nt->id];
+	double* buf = outsrc_buf_;
+	double** ps = poutsrc_;
+	int* ix = otd.ix;
+	for (int i = 0; i < otd.cnt; ++i) {
+		buf[ix[i]] = *ps[ix[i]];
+	}
+	if (_nt->id == 0) {
+		outsrc_packed_ = 1;
+	}
+}
+
+#if PARANEURON
+static void neighbor_exchange() {
+	int i, r;
+	for (i=0; i < n_insrc_rank_; ++i) {
+		r = insrc_rank_[i];
+		nrnmpi_postrecv_doubles(insrc_buf_ + insrcdspl_[r], insrccnt_[r],
+			r, PARTRANS_TAG, insrc_request_ + i);
+	}
+	// what this rank sends to itself
+	r = nrnmpi_myid;
+	for (i=0; i < insrccnt_[r]; ++i) {
+		insrc_buf_[insrcdspl_[r] + i] = outsrc_buf_[outsrcdspl_[r] + i];
+	}
+	for (i=0; i < n_outsrc_rank_; ++i) {
+		r = outsrc_rank_[i];
+		nrnmpi_send_doubles(outsrc_buf_ + outsrcdspl_[r], outsrccnt_[r],
+			r, PARTRANS_TAG);
+	}
+	for (i=0; i < n_insrc_rank_; ++i) {
+		nrnmpi_wait(insrc_request_ + i);
+	}
+}
+
+static void mk_neighbors() {
+	int i, n;
+	if (insrc_rank_) { delete [] insrc_rank_; insrc_rank_ = 0; }
+	if (outsrc_rank_) { delete [] outsrc_rank_; outsrc_rank_ = 0; }
+	if (insrc_request_) { delete [] insrc_request_; insrc_request_ = 0; }
+	n_insrc_rank_ = n_outsrc_rank_ = 0;
+	for (i=0; i < nrnmpi_numprocs; ++i) if (i != nrnmpi_myid) {
+		if (insrccnt_[i]) { ++n_insrc_rank_; }
+		if (outsrccnt_[i]) { ++n_outsrc_rank_; }
+	}
+	insrc_rank_ = new int[n_insrc_rank_ + 1];
+	insrc_request_ = new void*[n_insrc_rank_ + 1];
+	outsrc_rank_ = new int[n_outsrc_rank_ + 1];
+	n_insrc_rank_ = n_outsrc_rank_ = 0;
+	for (i=0; i < nrnmpi_numprocs; ++i) if (i != nrnmpi_myid) {
+		if (insrccnt_[i]) { insrc_rank_[n_insrc_rank_++] = i; }
+		if (outsrccnt_[i]) { outsrc_rank_[n_outsrc_rank_++] = i; }
+	}
+}
+#endif
+
 void mpi_transfer() {
 	int i, n = outsrc_buf_size_;
-	for (i=0; i < n; ++i) {
-		outsrc_buf_[i] = *poutsrc_[i];
+	if (outsrc_packed_) {
+		// already done by thread_outsrc_pack
+		outsrc_packed_ = 0;
+	}else{
+		for (i=0; i < n; ++i) {
+			outsrc_buf_[i] = *poutsrc_[i];
+		}
 	}
 #if PARANEURON
 	if (nrnmpi_numprocs > 1) {
 		double wt = nrnmpi_wtime();
-		nrnmpi_dbl_alltoallv(outsrc_buf_, outsrccnt_, outsrcdspl_,
-			insrc_buf_, insrccnt_, insrcdspl_);
+		if (transfer_neighbor_) {
+			neighbor_exchange();
+		}else{
+			nrnmpi_dbl_alltoallv(outsrc_buf_, outsrccnt_, outsrcdspl_,
+				insrc_buf_, insrccnt_, insrcdspl_);
+		}
 		nrnmpi_transfer_wait_ += nrnmpi_wtime() - wt;
 		errno = 0;
 	}
@@ -626,6 +816,11 @@ void thread_transfer(NrnThread* _nt) {
 		target_ptr_update();
 	}
 	TransferThreadData& ttd = transfer_thread_data_[_nt->id];
+	// when the sources were set earlier in this same thread job,
+	// wait for the threads that own them. Otherwise no-op.
+	for (int i = 0; i < ttd.nsrc_tid; ++i) {
+		nrn_thread_await(ttd.src_tid[i]);
+	}
 	for (int i = 0; i < ttd.cnt; ++i) {
 		*(ttd.tv[i]) = *(ttd.sv[i]);
 	}
@@ -664,8 +859,10 @@ void nrnmpi_setup_transfer() {
 //	xxxfile = fopen(ctmp, "w");
 	alloclists();
 	is_setup_ = true;
+	transfer_neighbor_ = ifarg(1) ? int(chkarg(1, 0, 1)) : 0;
 //	printf("nrnmpi_setup_transfer\n");
 	delete_imped_info();
+	rm_otd();
 	if (insrc_buf_) { delete [] insrc_buf_; insrc_buf_ = 0; }
 	if (outsrc_buf_) { delete [] outsrc_buf_; outsrc_buf_ = 0; }
 	if (sid2insrc_) { delete sid2insrc_; sid2insrc_ = 0; }
@@ -831,6 +1028,9 @@ void nrnmpi_setup_transfer() {
 	sid2insrc_ = seen; // since seen was constructed and then modified
 		// way above this. Might be better to reconstruct here.
 
+	// The ranks this rank actually exchanges with for pc.setup_transfer(1).
+	mk_neighbors();
+
 	nrnmpi_v_transfer_ = mpi_transfer;
     }	
 #endif //PARANEURON
@@ -867,6 +1067,7 @@ void nrn_partrans_clear() {
 	targets_ = 0;
 	max_targets_ = 0;
 	rm_svibuf();
+	rm_otd();
 	rm_ttd();
 	if (insrc_buf_) { delete [] insrc_buf_; insrc_buf_ = 0; }
 	if (outsrc_buf_) { delete [] outsrc_buf_; outsrc_buf_ = 0; }
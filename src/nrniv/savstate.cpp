@@ -23,6 +23,8 @@ extern NetCvode* net_cvode_instance;
 extern TQueue* net_cvode_instance_event_queue(NrnThread*);
 extern void clear_event_queue();
 extern hoc_Item* net_cvode_instance_psl();
+extern void nrn_psl_thr_invalid();
+extern void nrn_netcon_compact_materialize();
 extern PlayRecList* net_cvode_instance_prl();
 extern double t;
 extern short* nrn_is_artificial_;
@@ -261,6 +263,7 @@ void SaveState::ssi_def() {
 bool SaveState::check(bool warn) {
 	hoc_Item* qsec;
 	int isec;
+	nrn_netcon_compact_materialize();
 	if (nsec_ != section_count) {
 		if (warn) {
 fprintf(stderr, "SaveState warning: %d sections exist but saved %d\n",
@@ -911,6 +914,7 @@ void SaveState::restorenet() {
 		ps->told_ = pss_[i].told;
 		++i;
 	}
+	nrn_psl_thr_invalid();
 
 	// event queue
 	// clear it
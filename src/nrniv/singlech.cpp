@@ -250,8 +250,7 @@ double SingleChan::erand2() {
 void SingleChan::setrand(Rand* r) {
 	if (r) {
 		hoc_obj_ref(r->obj_);
-		delete r->rand;
-		r->rand = new NegativeExpntl(1.0, r->gen);
+		r->distribution(new NegativeExpntl(1.0, r->gen), Rand::RD_NEGEXP);
 		erand_ = &SingleChan::erand2;
 	}else{
 		erand_ = &SingleChan::erand1;
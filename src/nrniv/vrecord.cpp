@@ -203,6 +203,10 @@ void VecPlayStep::deliver(double tt, NetCvode* ns) {
 	}else{
 		*pd_ = y_->elem(current_index_++);
 	}
+	y_->map_advance(current_index_);
+	if (t_) {
+		t_->map_advance(current_index_);
+	}
 	if (current_index_ < y_->capacity()) {
 		if (t_) {
 			if (current_index_ < t_->capacity()) {
@@ -328,6 +332,8 @@ void VecPlayContinuous::continuous(double tt) {
 	}else{
 		*pd_ = interpolate(tt);
 	}
+	y_->map_advance(last_index_);
+	t_->map_advance(last_index_);
 }
 
 double VecPlayContinuous::interpolate(double tt) {
@@ -308,12 +308,15 @@ Section* nrnpy_newsection(void* v) {
 #endif
 
 void delete_section(void) {
-	Section* sec;
+	nrn_delete_section(chk_access());
+	hoc_retpushx(0.);
+}
+
+void nrn_delete_section(Section* sec) {
 	Object* ob;
 	Item** pitm;
 	Symbol* sym;
 	int i;
-	sec = chk_access();
 	if (!sec->prop->dparam[0].sym) {
 		hoc_execerror("Cannot delete an unnamed section", (char*)0);
 	}
@@ -327,7 +330,6 @@ void delete_section(void) {
 	}
 	sec_free(*pitm);
 	*pitm = 0;
-	hoc_retpushx(0.);
 }
 
 /*
@@ -579,15 +581,13 @@ void nrn_disconnect(Section* sec)
 	tree_changed = 1;
 }
 
-static void connectsec_impl(Section* parent, Section* sec)
+void nrn_connectsec(Section* sec, double d1, Section* parent, double d2)
+	/* connect sec(d1), parent(d2) */
 {
 	Section* ch;
 	Section* oldpsec = sec->parentsec;
 	Node* oldpnode = sec->parentnode;
-	double d1, d2;
 	Datum *pd;
-	d2 = xpop();
-	d1 = xpop();
 	if (d1 != 0. && d1 != 1.) {
 		hoc_execerror(secname(sec), " must connect at position 0 or 1");
 	}
@@ -633,17 +633,23 @@ void simpleconnectsection(void) /* 2 expr on stack and two sections on section s
 	/* for a prettier syntax: connect sec1(x), sec2(x) */
 {
 	Section* parent, *child;
+	double d1, d2;
 	parent = nrn_sec_pop();
 	child = nrn_sec_pop();
-	connectsec_impl(parent, child);	
+	d2 = xpop();
+	d1 = xpop();
+	nrn_connectsec(child, d1, parent, d2);
 }
 
 void connectsection(void) /* 2 expr on stack and section symbol on section stack */
 {
 	Section* parent, *child;
+	double d1, d2;
 	child = nrn_sec_pop();
 	parent = chk_access();
-	connectsec_impl(parent, child);
+	d2 = xpop();
+	d1 = xpop();
+	nrn_connectsec(child, d1, parent, d2);
 }
 
 static Section* Sec_access(void)	/* section symbol at pc */
@@ -905,14 +911,14 @@ void mech_uninsert1(Section* sec, Symbol* s)
 		mnext = sec->pnode[i]->prop;
 		if (mnext && mnext->type == type) {
 			sec->pnode[i]->prop = mnext->next;
-			single_prop_free(mnext);
+			nrn_node_prop_free(sec->pnode[i], mnext);
 			continue;
 		}
 		for (m = mnext; m; m = mnext) {
 			mnext = m->next;
 			if (mnext && mnext->type == type) {
 				m->next = mnext->next;
-				single_prop_free(mnext);
+				nrn_node_prop_free(sec->pnode[i], mnext);
 				break;
 			}
 		}
@@ -0,0 +1,773 @@
+#include <../../nrnconf.h>
+/*
+Bulk cell construction from a compact binary morphology file.
+Building many detailed cells with create, connect, pt3dadd and insert
+statements spends most of its time in the interpreter and in growing the
+3-d point arrays one point at a time. A CellLoader reads a file holding
+any number of cells and instantiates one of them with a single call:
+the sections are allocated together, each 3-d point array is allocated
+once at its final size, and mechanisms and parameters are applied per
+section rather than per statement.
+
+Usage is:
+
+objref cl, cells
+cells = new List()	// each item a SectionList holding one cell
+...
+cl = new CellLoader()
+cl.write("cells.dat", cells)	// or a single SectionList
+
+begintemplate Cell
+public sec
+create sec[1]
+proc init() {
+	$o1.build($2, "sec")	// sec becomes sec[0..nsec-1]
+}
+endtemplate Cell
+
+cl = new CellLoader("cells.dat")
+for i=0, cl.ncell - 1 { cell = new Cell(cl, i) }
+
+build(i, "name") must be called where "name" is already declared as a
+section (array) name, i.e. in the template (or at top level) whose
+sections are to be replaced. As with create, existing sections of that
+name are destroyed.
+
+All the cells built from the same record share its 3-d points, and the
+area and ri integrals computed from them (see Pt3dShare in section.h).
+A cell whose points are changed, e.g. translated to its position in a
+network, gets its own copy.
+
+The file uses native byte order:
+	char magic[8] "NRNCELL"
+	int version, nname
+	nname names, each int length followed by the characters.
+		A name is a density mechanism or a range variable.
+	int ncell
+	long long offset[ncell + 1]	byte offset of each cell, and the end
+	each cell: int nsec, then for each section
+		int parent (index within the cell or -1), nseg, npt, nmech, nval
+		double parentx, orientation, Ra, L, diam
+		double x[npt], y[npt], z[npt], d[npt]
+		int mech[nmech]	name index of each inserted mechanism
+		nval times: int name index, int n, double value[n]
+L and diam are used only when npt is 0. Values are assigned after all
+mechanisms are inserted. n is 1 for a value that is the same in every
+segment, else nseg values in segment order from 0 to 1. When npt is 0
+and diam is not uniform, diam is also one of the values.
+Version 1 files, with no n (always 1), can still be read.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "section.h"
+#include "membfunc.h"
+#include "parse.h"
+#include "hoc_membf.h"
+
+extern Objectdata* hoc_top_level_data;
+extern Symlist* hoc_top_level_symlist;
+extern Object* hoc_thisobject;
+extern Object* ivoc_list_item(Object*, int);
+extern void nrn_change_nseg(Section*, int);
+extern int diam_changed;
+
+#define CELLFILE_VERSION 2
+static char cellfile_magic[8] = "NRNCELL";
+
+typedef struct CellFile {
+	FILE* f;
+	int version;
+	int nname;
+	Symbol** names;
+	int ncell;
+	long long* offset;
+	char* buf;	/* one cell record */
+	size_t bufsize;
+	char* p;	/* read position in buf */
+	char* end;
+	double* pt;	/* scratch for 3-d points */
+	int ptsize;
+	Pt3dShare*** share;	/* per cell, per section, once built */
+	int* share_nsec;
+} CellFile;
+
+static void cf_close(CellFile* cf) {
+	int i, j;
+	if (cf->share) {
+		for (i = 0; i < cf->ncell; ++i) if (cf->share[i]) {
+			for (j = 0; j < cf->share_nsec[i]; ++j) {
+				if (cf->share[i][j]) {
+					nrn_pt3dshare_unref(cf->share[i][j]);
+				}
+			}
+			free(cf->share[i]);
+		}
+		free(cf->share);
+		free(cf->share_nsec);
+		cf->share = (Pt3dShare***)0;
+		cf->share_nsec = (int*)0;
+	}
+	if (cf->f) {
+		fclose(cf->f);
+		cf->f = (FILE*)0;
+	}
+	if (cf->names) {
+		free(cf->names);
+		cf->names = (Symbol**)0;
+	}
+	if (cf->offset) {
+		free(cf->offset);
+		cf->offset = (long long*)0;
+	}
+	cf->nname = 0;
+	cf->ncell = 0;
+}
+
+static void cf_fread(CellFile* cf, void* p, size_t size, size_t n) {
+	if (fread(p, size, n, cf->f) != n) {
+		cf_close(cf);
+		hoc_execerror("CellLoader:", "file is truncated");
+	}
+}
+
+static int cf_readint(CellFile* cf) {
+	int i;
+	cf_fread(cf, &i, sizeof(int), 1);
+	return i;
+}
+
+/* the name is a density mechanism or a range variable that can be
+   assigned, else nil
+*/
+static Symbol* cf_name_check(const char* name) {
+	Symbol* sym = hoc_lookup(name);
+	if (sym && sym->type == MECHANISM && !memb_func[sym->subtype].is_point) {
+		return sym;
+	}
+	if (sym && sym->type == RANGEVAR && !ISARRAY(sym)
+	    && sym->u.rng.type != 0 && sym->u.rng.type != CABLESECTION) {
+		return sym;
+	}
+	return (Symbol*)0;
+}
+
+/* on error, closes the file and frees what was allocated */
+static void cf_open(CellFile* cf, const char* fname) {
+	char magic[8];
+	char name[256];
+	int i, n;
+	cf->f = fopen(fname, "rb");
+	if (!cf->f) {
+		hoc_execerror("CellLoader: could not open", fname);
+	}
+	cf_fread(cf, magic, 1, 8);
+	if (memcmp(magic, cellfile_magic, 8) != 0) {
+		cf_close(cf);
+		hoc_execerror(fname, "is not a CellLoader file");
+	}
+	cf->version = cf_readint(cf);
+	if (cf->version < 1 || cf->version > CELLFILE_VERSION) {
+		cf_close(cf);
+		hoc_execerror(fname, "has an unsupported CellLoader file version");
+	}
+	cf->nname = cf_readint(cf);
+	if (cf->nname < 0) {
+		cf_close(cf);
+		hoc_execerror(fname, "has a corrupt name table");
+	}
+	cf->names = (Symbol**)ecalloc(cf->nname + 1, sizeof(Symbol*));
+	for (i = 0; i < cf->nname; ++i) {
+		n = cf_readint(cf);
+		if (n < 1 || n >= 256) {
+			cf_close(cf);
+			hoc_execerror(fname, "has a corrupt name table");
+		}
+		cf_fread(cf, name, 1, n);
+		name[n] = '\0';
+		cf->names[i] = cf_name_check(name);
+		if (!cf->names[i]) {
+			cf_close(cf);
+hoc_execerror(name, "is not a density mechanism or scalar range variable");
+		}
+	}
+	cf->ncell = cf_readint(cf);
+	if (cf->ncell < 0) {
+		cf->ncell = 0;
+		cf_close(cf);
+		hoc_execerror(fname, "has a corrupt cell count");
+	}
+	cf->offset = (long long*)emalloc((cf->ncell + 1)*sizeof(long long));
+	cf_fread(cf, cf->offset, sizeof(long long), cf->ncell + 1);
+	cf->share = (Pt3dShare***)ecalloc(cf->ncell, sizeof(Pt3dShare**));
+	cf->share_nsec = (int*)ecalloc(cf->ncell, sizeof(int));
+}
+
+/* read the whole record of cell i into buf */
+static void cf_cell(CellFile* cf, int i) {
+	size_t size = (size_t)(cf->offset[i+1] - cf->offset[i]);
+	if (size > cf->bufsize) {
+		cf->buf = (char*)erealloc(cf->buf, size);
+		cf->bufsize = size;
+	}
+	if (fseek(cf->f, (long)cf->offset[i], SEEK_SET) != 0) {
+		hoc_execerror("CellLoader:", "seek failed");
+	}
+	if (fread(cf->buf, 1, size, cf->f) != size) {
+		hoc_execerror("CellLoader:", "file is truncated");
+	}
+	cf->p = cf->buf;
+	cf->end = cf->buf + size;
+}
+
+static void cf_get(CellFile* cf, void* dest, size_t size) {
+	if (cf->p + size > cf->end) {
+		hoc_execerror("CellLoader:", "cell record is corrupt");
+	}
+	memcpy(dest, cf->p, size);
+	cf->p += size;
+}
+
+static int cf_getint(CellFile* cf) {
+	int i;
+	cf_get(cf, &i, sizeof(int));
+	return i;
+}
+
+static double cf_getdouble(CellFile* cf) {
+	double x;
+	cf_get(cf, &x, sizeof(double));
+	return x;
+}
+
+static void cf_skip(CellFile* cf, size_t size) {
+	if (cf->p + size > cf->end) {
+		hoc_execerror("CellLoader:", "cell record is corrupt");
+	}
+	cf->p += size;
+}
+
+static Symbol* cf_getname(CellFile* cf) {
+	int i = cf_getint(cf);
+	if (i < 0 || i >= cf->nname) {
+		hoc_execerror("CellLoader:", "name index out of range");
+	}
+	return cf->names[i];
+}
+
+typedef struct SecHead {
+	int parent, nseg, npt, nmech, nval;
+	double parentx, orient, Ra, L, diam;
+} SecHead;
+
+static void cf_sechead(CellFile* cf, SecHead* h) {
+	h->parent = cf_getint(cf);
+	h->nseg = cf_getint(cf);
+	h->npt = cf_getint(cf);
+	h->nmech = cf_getint(cf);
+	h->nval = cf_getint(cf);
+	h->parentx = cf_getdouble(cf);
+	h->orient = cf_getdouble(cf);
+	h->Ra = cf_getdouble(cf);
+	h->L = cf_getdouble(cf);
+	h->diam = cf_getdouble(cf);
+	if (h->nseg < 1 || h->npt < 0 || h->nmech < 0 || h->nval < 0) {
+		hoc_execerror("CellLoader:", "cell record is corrupt");
+	}
+}
+
+/* number of values that follow a value name, 1 or nseg */
+static int cf_getnval(CellFile* cf, int nseg) {
+	int n = (cf->version > 1) ? cf_getint(cf) : 1;
+	if (n != 1 && n != nseg) {
+		hoc_execerror("CellLoader:", "cell record is corrupt");
+	}
+	return n;
+}
+
+/* skip the mechanism and value lists of a section */
+static void cf_skipmembrane(CellFile* cf, SecHead* h) {
+	int j;
+	cf_skip(cf, h->nmech*sizeof(int));
+	for (j = 0; j < h->nval; ++j) {
+		cf_skip(cf, sizeof(int));
+		cf_skip(cf, cf_getnval(cf, h->nseg)*sizeof(double));
+	}
+}
+
+/*ARGSUSED*/
+static void* cons(Object* ho) {
+	CellFile cf0, *cf;
+	memset(&cf0, 0, sizeof(CellFile));
+	if (ifarg(1)) {
+		cf_open(&cf0, gargstr(1));
+	}
+	cf = (CellFile*)emalloc(sizeof(CellFile));
+	*cf = cf0;
+	return (void*)cf;
+}
+
+static void destruct(void* v) {
+	CellFile* cf = (CellFile*)v;
+	cf_close(cf);
+	if (cf->buf) {
+		free(cf->buf);
+	}
+	if (cf->pt) {
+		free(cf->pt);
+	}
+	free(cf);
+}
+
+static double cl_ncell(void* v) {
+	return (double)((CellFile*)v)->ncell;
+}
+
+static double cl_nsec(void* v) {
+	CellFile* cf = (CellFile*)v;
+	int i = (int)chkarg(1, 0., (double)(cf->ncell - 1));
+	cf_cell(cf, i);
+	return (double)cf_getint(cf);
+}
+
+/* replace the sections of the named array with n new ones, as create does */
+static hoc_Item** cl_create(const char* name, int n) {
+	Symbol* sym;
+	Object* ob;
+	hoc_Item** pitm;
+	size_t total, i;
+	if (hoc_objectdata == hoc_top_level_data) {
+		ob = (Object*)0;
+		sym = hoc_table_lookup(name, hoc_top_level_symlist);
+	}else{
+		ob = hoc_thisobject;
+		sym = hoc_table_lookup(name, ob->template->symtable);
+	}
+	if (!sym || sym->type != SECTION) {
+		hoc_execerror(name, "must already be declared as a section name");
+	}
+	total = hoc_total_array(sym);
+	for (i = 0; i < total; ++i) {
+		sec_free(*(OPSECITM(sym) + i));
+	}
+	free((char*)OPSECITM(sym));
+	hoc_freearay(sym);
+	hoc_pushx((double)n);
+	hoc_arayinfo_install(sym, 1);
+	pitm = (hoc_Item**)emalloc(n*sizeof(hoc_Item*));
+	hoc_objectdata[sym->u.oboff].psecitm = pitm;
+	new_sections(ob, sym, pitm, n);
+	return pitm;
+}
+
+static double cl_build(void* v) {
+	static Symbol* diamsym;
+	CellFile* cf = (CellFile*)v;
+	int icell = (int)chkarg(1, 0., (double)(cf->ncell - 1));
+	int nsec, i, j, k, n;
+	double val;
+	SecHead h;
+	Pt3dShare** share;
+	hoc_Item** pitm;
+	Section* sec;
+	Symbol* sym;
+	char* start;
+
+	if (!diamsym) {
+		diamsym = hoc_lookup("diam");
+	}
+	cf_cell(cf, icell);
+	nsec = cf_getint(cf);
+	if (nsec < 1) {
+		hoc_execerror("CellLoader:", "cell has no sections");
+	}
+	pitm = cl_create(gargstr(2), nsec);
+	if (!cf->share[icell]) {
+		cf->share[icell] = (Pt3dShare**)ecalloc(nsec, sizeof(Pt3dShare*));
+		cf->share_nsec[icell] = nsec;
+	}
+	share = cf->share[icell];
+	start = cf->p;
+	/* first pass: topology and geometry. All the sections exist so
+	   a parent may follow its child in the file.
+	*/
+	for (i = 0; i < nsec; ++i) {
+		sec = hocSEC(pitm[i]);
+		cf_sechead(cf, &h);
+		if (h.parent >= nsec) {
+			hoc_execerror("CellLoader:", "parent index out of range");
+		}
+		if (h.nseg != sec->nnode - 1) {
+			nrn_change_nseg(sec, h.nseg);
+		}
+		sec->prop->dparam[7].val = h.Ra;
+		if (h.parent >= 0) {
+			nrn_connectsec(sec, h.orient, hocSEC(pitm[h.parent]), h.parentx);
+		}
+		if (h.npt > 0 && share[i]) {
+			cf_skip(cf, 4*h.npt*sizeof(double));
+			nrn_pt3dshare_use(sec, share[i]);
+		}else if (h.npt > 0) {
+			if (4*h.npt > cf->ptsize) {
+				cf->ptsize = 4*h.npt;
+				cf->pt = (double*)erealloc(cf->pt, cf->ptsize*sizeof(double));
+			}
+			cf_get(cf, cf->pt, 4*h.npt*sizeof(double));
+			nrn_pt3dset(sec, h.npt, cf->pt, cf->pt + h.npt,
+				cf->pt + 2*h.npt, cf->pt + 3*h.npt);
+			share[i] = nrn_pt3dshare(sec);
+		}else{
+			sec->prop->dparam[2].val = h.L;
+			sec->recalc_area_ = 1;
+			nrn_rangeconst(sec, diamsym, &h.diam, 0);
+		}
+		cf_skipmembrane(cf, &h);
+	}
+	/* second pass: membrane. Values are assigned after the section's
+	   mechanisms (and the ions they use) are inserted.
+	*/
+	cf->p = start;
+	for (i = 0; i < nsec; ++i) {
+		sec = hocSEC(pitm[i]);
+		cf_sechead(cf, &h);
+		cf_skip(cf, 4*h.npt*sizeof(double));
+		for (j = 0; j < h.nmech; ++j) {
+			sym = cf_getname(cf);
+			if (sym->type != MECHANISM) {
+				hoc_execerror(sym->name, "is not a mechanism");
+			}
+			mech_insert1(sec, sym->subtype);
+		}
+		for (j = 0; j < h.nval; ++j) {
+			sym = cf_getname(cf);
+			n = cf_getnval(cf, h.nseg);
+			if (sym->type != RANGEVAR) {
+				hoc_execerror(sym->name, "is not a range variable");
+			}
+			if (n == 1) {
+				val = cf_getdouble(cf);
+				nrn_rangeconst(sec, sym, &val, 0);
+				continue;
+			}
+			for (k = 0; k < n; ++k) {
+				val = cf_getdouble(cf);
+				*nrn_rangepointer(sec, sym, (k + .5)/n) = val;
+			}
+			if (sym == diamsym) {
+				sec->recalc_area_ = 1;
+				diam_changed = 1;
+			}
+		}
+	}
+	return (double)nsec;
+}
+
+/* writing */
+
+typedef struct CellWriter {
+	FILE* f;
+	Symbol** names;
+	int nname;
+	Prop** props;	/* of a node, in insertion order */
+	int nprop;
+	Section** secs;	/* of a cell */
+	int nsec, maxsec;
+	double* val;	/* of a range variable, per segment */
+	int valsize;
+	long long* offset;
+} CellWriter;
+
+static void cw_free(CellWriter* cw) {
+	if (cw->f) {
+		fclose(cw->f);
+	}
+	if (cw->props) {
+		free(cw->props);
+	}
+	if (cw->names) {
+		free(cw->names);
+	}
+	if (cw->secs) {
+		free(cw->secs);
+	}
+	if (cw->val) {
+		free(cw->val);
+	}
+	if (cw->offset) {
+		free(cw->offset);
+	}
+	memset(cw, 0, sizeof(CellWriter));
+}
+
+static void cw_error(CellWriter* cw, const char* s1, const char* s2) {
+	cw_free(cw);
+	hoc_execerror(s1, s2);
+}
+
+static void cw_write(CellWriter* cw, const void* p, size_t size, size_t n) {
+	if (fwrite(p, size, n, cw->f) != n) {
+		cw_error(cw, "CellLoader.write:", "write failed");
+	}
+}
+
+static void cw_int(CellWriter* cw, int i) {
+	cw_write(cw, &i, sizeof(int), 1);
+}
+
+static void cw_double(CellWriter* cw, double x) {
+	cw_write(cw, &x, sizeof(double), 1);
+}
+
+static int cw_name(CellWriter* cw, Symbol* sym) {
+	int i;
+	for (i = 0; i < cw->nname; ++i) {
+		if (cw->names[i] == sym) {
+			return i;
+		}
+	}
+	cw->names = (Symbol**)erealloc(cw->names, (cw->nname + 1)*sizeof(Symbol*));
+	cw->names[cw->nname] = sym;
+	return cw->nname++;
+}
+
+/* the cell is the sections of a SectionList */
+static void cw_cell(CellWriter* cw, Object* ob) {
+	hoc_Item* q;
+	if (!ob || !is_obj_type(ob, "SectionList")) {
+		cw_error(cw, "CellLoader.write:", "a cell must be a SectionList");
+	}
+	cw->nsec = 0;
+	ITERATE(q, (hoc_List*)ob->u.this_pointer) {
+		if (!hocSEC(q)->prop) { /* deleted */
+			continue;
+		}
+		if (cw->nsec == cw->maxsec) {
+			cw->maxsec = 2*cw->maxsec + 10;
+			cw->secs = (Section**)erealloc(cw->secs, cw->maxsec*sizeof(Section*));
+		}
+		cw->secs[cw->nsec++] = hocSEC(q);
+	}
+}
+
+static int cw_secindex(CellWriter* cw, Section* sec) {
+	int i;
+	for (i = 0; i < cw->nsec; ++i) {
+		if (cw->secs[i] == sec) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+/* the density mechanisms of nd, at most one of each type. Point processes,
+   any number of them, are not part of a CellLoader file.
+*/
+static void cw_props(CellWriter* cw, Node* nd) {
+	Prop* p;
+	int n = 0;
+	for (p = nd->prop; p; p = p->next) {
+		if (!memb_func[p->type].is_point) {
+			++n;
+		}
+	}
+	cw->nprop = n;
+	for (p = nd->prop; p; p = p->next) {
+		if (!memb_func[p->type].is_point) {
+			cw->props[--n] = p;
+		}
+	}
+}
+
+static int cw_is_inserted(Prop* p) {
+	return p->type != MORPHOLOGY && p->type != CAP
+		&& !nrn_is_ion(p->type) && !memb_func[p->type].is_point;
+}
+
+/* range variables that are PARAMETERs */
+static int cw_is_param(Prop* p, Symbol* s) {
+	int vt = s->subtype;
+	if (ISARRAY(s) || p->ob || memb_func[p->type].is_point) {
+		return 0;
+	}
+	if (vt == _AMBIGUOUS) { /* ion variable, see nrn_vartype */
+		int it = p->dparam[0].i;
+		vt = (s->u.rng.index == 0) ? (it & 030)>>3 : (it & 03);
+	}
+	return vt == nrnocCONST;
+}
+
+/* the value of s in each segment of sec, into cw->val. Returns 1 if they
+   are all the same, else nseg.
+*/
+static int cw_values(CellWriter* cw, Section* sec, Symbol* s) {
+	int i, nseg = sec->nnode - 1;
+	if (nseg > cw->valsize) {
+		cw->valsize = nseg;
+		cw->val = (double*)erealloc(cw->val, nseg*sizeof(double));
+	}
+	for (i = 0; i < nseg; ++i) {
+		cw->val[i] = *nrn_rangepointer(sec, s, (i + .5)/nseg);
+	}
+	for (i = 1; i < nseg; ++i) {
+		if (cw->val[i] != cw->val[0]) {
+			return nseg;
+		}
+	}
+	return 1;
+}
+
+static void cw_values_write(CellWriter* cw, Section* sec, Symbol* s) {
+	int n = cw_values(cw, sec, s);
+	cw_int(cw, cw_name(cw, s));
+	cw_int(cw, n);
+	cw_write(cw, cw->val, sizeof(double), n);
+}
+
+/* pass 0 collects the names, pass 1 writes the sections of the cell */
+static void cw_sections(CellWriter* cw, int pass) {
+	static Symbol* diamsym;
+	int i, j, k, nmech, nval, diamval;
+	Section* sec;
+	Symbol* msym;
+	Prop* p;
+	if (!diamsym) {
+		diamsym = hoc_lookup("diam");
+	}
+	for (i = 0; i < cw->nsec; ++i) {
+		sec = cw->secs[i];
+		if (sec->recalc_area_ && sec->npt3d) {
+			nrn_area_ri(sec); /* diam from the 3-d points */
+		}
+		cw_props(cw, sec->pnode[0]);
+		/* with 3-d points they define diam */
+		diamval = sec->npt3d == 0 && cw_values(cw, sec, diamsym) > 1;
+		nmech = 0;
+		nval = diamval;
+		if (diamval && pass == 0) {
+			cw_name(cw, diamsym);
+		}
+		for (j = 0; j < cw->nprop; ++j) {
+			p = cw->props[j];
+			msym = memb_func[p->type].sym;
+			if (cw_is_inserted(p)) {
+				++nmech;
+				if (pass == 0) {
+					cw_name(cw, msym);
+				}
+			}
+			if (p->type == MORPHOLOGY) {
+				continue;
+			}
+			for (k = 0; k < msym->s_varn; ++k) {
+				if (cw_is_param(p, msym->u.ppsym[k])) {
+					++nval;
+					if (pass == 0) {
+						cw_name(cw, msym->u.ppsym[k]);
+					}
+				}
+			}
+		}
+		if (pass == 0) {
+			continue;
+		}
+		cw_int(cw, sec->parentsec ? cw_secindex(cw, sec->parentsec) : -1);
+		cw_int(cw, sec->nnode - 1);
+		cw_int(cw, sec->npt3d);
+		cw_int(cw, nmech);
+		cw_int(cw, nval);
+		cw_double(cw, nrn_connection_position(sec));
+		cw_double(cw, nrn_section_orientation(sec));
+		cw_double(cw, sec->prop->dparam[7].val);
+		cw_double(cw, sec->prop->dparam[2].val);
+		cw_double(cw, nrn_diameter(sec->pnode[0]));
+		for (k = 0; k < sec->npt3d; ++k) cw_double(cw, sec->pt3d[k].x);
+		for (k = 0; k < sec->npt3d; ++k) cw_double(cw, sec->pt3d[k].y);
+		for (k = 0; k < sec->npt3d; ++k) cw_double(cw, sec->pt3d[k].z);
+		for (k = 0; k < sec->npt3d; ++k) cw_double(cw, sec->pt3d[k].d);
+		for (j = 0; j < cw->nprop; ++j) {
+			p = cw->props[j];
+			if (cw_is_inserted(p)) {
+				cw_int(cw, cw_name(cw, memb_func[p->type].sym));
+			}
+		}
+		if (diamval) {
+			cw_values_write(cw, sec, diamsym);
+		}
+		for (j = 0; j < cw->nprop; ++j) {
+			p = cw->props[j];
+			msym = memb_func[p->type].sym;
+			if (p->type == MORPHOLOGY) {
+				continue;
+			}
+			for (k = 0; k < msym->s_varn; ++k) {
+				Symbol* s = msym->u.ppsym[k];
+				if (cw_is_param(p, s)) {
+					cw_values_write(cw, sec, s);
+				}
+			}
+		}
+	}
+}
+
+static double cl_write(void* v) {
+	CellWriter cw;
+	Object* ob = *hoc_objgetarg(2);
+	char* fname = gargstr(1);
+	int i, ncell, islist;
+	long otab;
+
+	islist = ob && is_obj_type(ob, "List");
+	ncell = islist ? ivoc_list_count(ob) : 1;
+	memset(&cw, 0, sizeof(CellWriter));
+	cw.props = (Prop**)emalloc(n_memb_func*sizeof(Prop*));
+	for (i = 0; i < ncell; ++i) {
+		cw_cell(&cw, islist ? ivoc_list_item(ob, i) : ob);
+		cw_sections(&cw, 0);
+	}
+	cw.f = fopen(fname, "wb");
+	if (!cw.f) {
+		cw_error(&cw, "CellLoader.write: could not open", fname);
+	}
+	cw_write(&cw, cellfile_magic, 1, 8);
+	cw_int(&cw, CELLFILE_VERSION);
+	cw_int(&cw, cw.nname);
+	for (i = 0; i < cw.nname; ++i) {
+		int n = strlen(cw.names[i]->name);
+		cw_int(&cw, n);
+		cw_write(&cw, cw.names[i]->name, 1, n);
+	}
+	cw_int(&cw, ncell);
+	otab = ftell(cw.f);
+	cw.offset = (long long*)ecalloc(ncell + 1, sizeof(long long));
+	cw_write(&cw, cw.offset, sizeof(long long), ncell + 1);
+	for (i = 0; i < ncell; ++i) {
+		cw.offset[i] = ftell(cw.f);
+		cw_cell(&cw, islist ? ivoc_list_item(ob, i) : ob);
+		cw_int(&cw, cw.nsec);
+		cw_sections(&cw, 1);
+	}
+	cw.offset[ncell] = ftell(cw.f);
+	fseek(cw.f, otab, SEEK_SET);
+	cw_write(&cw, cw.offset, sizeof(long long), ncell + 1);
+	if (fclose(cw.f) != 0) {
+		cw.f = (FILE*)0;
+		cw_error(&cw, "CellLoader.write:", "write failed");
+	}
+	cw.f = (FILE*)0;
+	cw_free(&cw);
+	return (double)ncell;
+}
+
+static Member_func members[] = {
+	"ncell", cl_ncell,
+	"nsec", cl_nsec,
+	"build", cl_build,
+	"write", cl_write,
+	0, 0
+};
+
+void CellLoader_reg(void) {
+	void class2oc();
+	class2oc("CellLoader", cons, destruct, members, (void*)0, (void*)0, (void*)0);
+}
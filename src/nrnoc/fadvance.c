@@ -68,6 +68,7 @@ extern void nrncvode_set_t(double t);
 
 static void* nrn_ms_treeset_through_triang(NrnThread*);
 static void* nrn_ms_reduce_solve(NrnThread*);
+static void ms_reduce_solve();
 static void* nrn_ms_bksub(NrnThread*);
 static void* nrn_ms_bksub_through_triang(NrnThread*);
 extern void* nrn_multisplit_triang(NrnThread*);
@@ -153,12 +154,17 @@ thread handling where it was before. Also, writing to the staging area
 is only done by thread 0. Fixed step and global variable step
 logic is limited to the case where an nrnmpi_v_transfer requires
 existence of nrnthread_v_transfer (even if one thread).
+For the fixed step method each thread gathers its own source values into
+the mpi send buffer with nrnthread_v_pack at the end of the thread job
+containing update so that thread 0 only does the exchange.
 */
 #if 1 || PARANEURON
 void (*nrnmpi_v_transfer_)(); /* called by thread 0 */
 void (*nrnthread_v_transfer_)(NrnThread* nt);
 /* if at least one gap junction has a source voltage with extracellular inserted */
 void (*nrnthread_vi_compute_)(NrnThread* nt);
+/* if there is an nrnmpi_v_transfer. after update and before it */
+void (*nrnthread_v_pack_)(NrnThread* nt);
 #endif
 
 #if VECTORIZE
@@ -321,7 +327,7 @@ void nrn_fixed_step() {
 		// v transfer and others do a spike exchange.
 		// i.e. must complete the full multisplit time step.
 		//if (!nrn_allthread_handle) {
-			nrn_multithread_job(nrn_ms_reduce_solve);
+			ms_reduce_solve();
 			nrn_multithread_job(nrn_ms_bksub);
 			/* see comment below */
 			if (nrnthread_v_transfer_) {
@@ -367,7 +373,7 @@ void nrn_fixed_step_group(int n) {
 		nrn_multithread_job(nrn_ms_treeset_through_triang);
 		step_group_n = 0; /* abort at bksub flag */
 		for (i=1; i < n; ++i) {
-			nrn_multithread_job(nrn_ms_reduce_solve);
+			ms_reduce_solve();
 			nrn_multithread_job(nrn_ms_bksub_through_triang);
 			if (step_group_n) {
 				step_group_n = 0;
@@ -385,7 +391,7 @@ void nrn_fixed_step_group(int n) {
 			b = 0;
 		}
 		if (!b) {
-			nrn_multithread_job(nrn_ms_reduce_solve);
+			ms_reduce_solve();
 			nrn_multithread_job(nrn_ms_bksub);
 		}
 		if (nrn_allthread_handle) { (*nrn_allthread_handle)(); }
@@ -421,6 +427,7 @@ void* nrn_fixed_step_group_thread(NrnThread* nth) {
 
 void* nrn_fixed_step_thread(NrnThread* nth) {
 	double wt;
+	unsigned long long t0;
 	deliver_net_events(nth);
 	wt = nrnmpi_wtime();
 	nrn_random_play(nth);
@@ -432,7 +439,9 @@ void* nrn_fixed_step_thread(NrnThread* nth) {
 #endif
 	fixed_play_continuous(nth);
 	setup_tree_matrix(nth);
+	NRN_PROF_BEGIN(t0)
 	nrn_solve(nth);
+	NRN_PROF_END(t0, nth, NRN_PROF_SOLVE, 0)
 	second_order_cur(nth);
 	update(nth);
 	CTADD
@@ -442,6 +451,8 @@ void* nrn_fixed_step_thread(NrnThread* nth) {
 */
 	if (!nrnthread_v_transfer_) {
 		nrn_fixed_step_lastpart(nth);
+	}else if (nrnthread_v_pack_) {
+		(*nrnthread_v_pack_)(nth);
 	}
 	return (void*)0;
 }
@@ -480,6 +491,7 @@ void* nrn_fixed_step_lastpart(NrnThread* nth) {
 
 void* nrn_ms_treeset_through_triang(NrnThread* nth) {
 	double wt;
+	unsigned long long t0;
 	deliver_net_events(nth);
 	wt = nrnmpi_wtime();
 	nrn_random_play(nth);
@@ -491,23 +503,42 @@ void* nrn_ms_treeset_through_triang(NrnThread* nth) {
 #endif
 	fixed_play_continuous(nth);
 	setup_tree_matrix(nth);
+	NRN_PROF_BEGIN(t0)
 	nrn_multisplit_triang(nth);
+	NRN_PROF_END(t0, nth, NRN_PROF_SOLVE, 0)
 	CTADD
 	return (void*)0;
 }
 void* nrn_ms_reduce_solve(NrnThread* nth) {
+	unsigned long long t0;
+	NRN_PROF_BEGIN(t0)
 	nrn_multisplit_reduce_solve(nth);
+	NRN_PROF_END(t0, nth, NRN_PROF_SOLVE, 0)
 	return (void*)0;
 }
+/* the threads that run concurrently share the reduced tree solves */
+static void ms_reduce_solve() {
+	if (nrn_thread_publish_begin()) {
+		nrn_multithread_job(nrn_ms_reduce_solve);
+		nrn_thread_publish_end();
+	}else{
+		nrn_multithread_job(nrn_ms_reduce_solve);
+	}
+}
 void* nrn_ms_bksub(NrnThread* nth) {
+	unsigned long long t0;
 	CTBEGIN
+	NRN_PROF_BEGIN(t0)
 	nrn_multisplit_bksub(nth);
+	NRN_PROF_END(t0, nth, NRN_PROF_SOLVE, 0)
 	second_order_cur(nth);
 	update(nth);
 	CTADD
 /* see above comment in nrn_fixed_step_thread */
 	if (!nrnthread_v_transfer_) {
 		nrn_fixed_step_lastpart(nth);
+	}else if (nrnthread_v_pack_) {
+		(*nrnthread_v_pack_)(nth);
 	}
 	return (void*)0;
 }
@@ -688,6 +719,7 @@ void nonvint(NrnThread* _nt)
 	int i=0;
 	double w;
 	int measure = 0;
+	unsigned long long t0;
 	NrnThreadMembList* tml;
 #if 1 || PARANEURON
 	/* nrnmpi_v_transfer if needed was done earlier */
@@ -698,7 +730,9 @@ void nonvint(NrnThread* _nt)
 	for (tml = _nt->tml; tml; tml = tml->next) if (memb_func[tml->index].state) {
 		Pvmi s = memb_func[tml->index].state;
 		if (measure) { w = nrnmpi_wtime(); }
+		NRN_PROF_BEGIN(t0)
 		(*s)(_nt, tml->ml, tml->index);
+		NRN_PROF_END(t0, _nt, NRN_PROF_STATE, tml->index)
 		if (measure) { nrn_mech_wtime_[tml->index] += nrnmpi_wtime() - w; }
 		if (errno) {
 			if (nrn_errno_check(i)) {
@@ -759,6 +793,7 @@ void verify_structure(void) {
 	if (diam_changed) {
 		recalc_diam();
 	}
+	nrn_cache_prop_update();
 	nrn_solver_prepare(); /* cvode ready to be used */
 }
 	
@@ -801,6 +836,9 @@ void nrn_finitialize(int setv, double v) {
 	if (nrnthread_vi_compute_) FOR_THREADS(_nt){
 		(*nrnthread_vi_compute_)(_nt);
 	}
+	if (nrnthread_v_pack_) FOR_THREADS(_nt){
+		(*nrnthread_v_pack_)(_nt);
+	}
 	if (nrnmpi_v_transfer_) {
 		(nrnmpi_v_transfer_)();
 	}
@@ -1013,13 +1051,16 @@ void batch_save(void) {
 void nrn_ba(NrnThread* nt, int bat){
 	NrnThreadBAList* tbl;
 	int i;
+	unsigned long long t0;
 	for (tbl = nt->tbl[bat]; tbl; tbl = tbl->next) {
 		nrn_bamech_t f = tbl->bam->f;
 		int type = tbl->bam->type;
 		Memb_list* ml = tbl->ml;
+		NRN_PROF_BEGIN(t0)
 		for (i=0; i < ml->nodecount; ++i) {
 			(*f)(ml->nodelist[i], ml->data[i], ml->pdata[i], ml->_thread, nt);
 		}
+		NRN_PROF_END(t0, nt, NRN_PROF_BA, type)
 	}
 }
 
@@ -320,6 +320,7 @@ void hoc_last_init(void)
 	}
 	SectionList_reg();
 	SectionRef_reg();
+	CellLoader_reg();
 	register_mech(morph_mech, morph_alloc, (Pvmi)0, (Pvmi)0, (Pvmi)0, (Pvmi)0, -1, 0);
 	for (m = mechanism; *m; m++) {
 		(*m)();
@@ -441,6 +442,7 @@ void nrn_register_mech_common(
 	memb_func[type].hoc_mech = (void*)0;
 	memb_func[type].setdata_ = (void*)0;
 	memb_func[type].dparam_semantics = (int*)0;
+	memb_func[type].fused_jacob = 0;
 	memb_list[type].nodecount = 0;
 	memb_list[type]._thread = (Datum*)0;
 	memb_order_[type] = type;
@@ -664,6 +666,10 @@ void hoc_register_synonym(int i, void (*syn)(int, double**, Datum**)){
 }
 #endif
 
+void hoc_register_fused_jacob(int type) {
+	memb_func[type].fused_jacob = 1;
+}
+
 void register_destructor(Pvmp d) {
 	memb_func[n_memb_func - 1].destructor = d;
 }
@@ -47,6 +47,7 @@ typedef struct Memb_func {
 	void* hoc_mech;
 	void (*setdata_)(struct Prop*);
 	int* dparam_semantics; // for nrncore writing.
+	int fused_jacob; /* nrn_cur can do the work of jacob. See treeset.c */
 } Memb_func;
 
 
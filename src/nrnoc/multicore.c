@@ -52,6 +52,8 @@ extern void nrn_old_thread_save();
 extern double nrn_timeus();
 
 static int nrn_thread_parallel_;
+static int nrn_vec_multithread(void (*job)(int, int));
+extern int (*nrn_vec_multithread_p_)(void (*job)(int, int));
 void nrn_mk_table_check();
 static int table_check_cnt_;
 static Datum* table_check_;
@@ -516,6 +518,7 @@ void nrn_threads_create(int n, int parallel) {
 				nt->_dt = -1e9;
 				nt->id = i;
 				nt->_stop_stepping = 0;
+				nt->_fused_jacob = 0;
 				nt->tml = (NrnThreadMembList*)0;
 				nt->roots = (hoc_List*)0;
 				nt->userpart = 0;
@@ -543,15 +546,80 @@ void nrn_threads_create(int n, int parallel) {
 		v_structure_change = 1;
 		diam_changed = 1;
 	}
+	nrn_vec_multithread_p_ = nrn_vec_multithread;
 	if (nrn_thread_parallel_ != parallel) {
 		threads_free_pthread();
 		if (parallel) {
 			threads_create_pthread();
 		}
 	}
+	if (nrn_prof_on_ && nrn_prof_nthread_ != nrn_nthread) {
+		nrn_prof_alloc(nrn_nthread, n_memb_func);
+	}
 	/*printf("nrn_threads_create %d %d\n", nrn_nthread, nrn_thread_parallel_);*/
 }
 
+/*
+Profiling counters. Each thread gets its own cacheline aligned row so
+the threads do not write into each others cache lines. The ticks are
+converted to seconds with the ratio of elapsed wall time to elapsed ticks
+since nrn_prof_alloc (up to the time profiling was turned off).
+*/
+int nrn_prof_on_;
+int nrn_prof_ntype_;
+int nrn_prof_nthread_;
+unsigned long long** nrn_prof_;
+static double prof_wt_[2];
+static unsigned long long prof_tick_[2];
+
+unsigned long long nrn_prof_ticks() {
+	return (unsigned long long)(nrnmpi_wtime()*1e9);
+}
+
+void nrn_prof_alloc(int nthread, int ntype) {
+	int i;
+	if (nrn_prof_) {
+		for (i=0; i < nrn_prof_nthread_; ++i) {
+			free((char*)nrn_prof_[i]);
+		}
+		free((char*)nrn_prof_);
+		nrn_prof_ = (unsigned long long**)0;
+	}
+	nrn_prof_nthread_ = 0;
+	nrn_prof_ntype_ = 0;
+	if (nthread > 0) {
+		nrn_prof_ = (unsigned long long**)ecalloc(nthread, sizeof(unsigned long long*));
+		for (i=0; i < nthread; ++i) {
+			CACHELINE_CALLOC(nrn_prof_[i], unsigned long long, NRN_PROF_NKIND*ntype);
+		}
+		nrn_prof_nthread_ = nthread;
+		nrn_prof_ntype_ = ntype;
+	}
+	prof_wt_[0] = nrnmpi_wtime();
+	prof_tick_[0] = nrn_prof_clock();
+}
+
+void nrn_prof_stop() {
+	if (nrn_prof_on_) {
+		prof_wt_[1] = nrnmpi_wtime();
+		prof_tick_[1] = nrn_prof_clock();
+		nrn_prof_on_ = 0;
+	}
+}
+
+double nrn_prof_tick2sec() {
+	double wt = prof_wt_[1];
+	unsigned long long tick = prof_tick_[1];
+	if (nrn_prof_on_) {
+		wt = nrnmpi_wtime();
+		tick = nrn_prof_clock();
+	}
+	if (tick <= prof_tick_[0]) {
+		return 0.;
+	}
+	return (wt - prof_wt_[0])/(double)(tick - prof_tick_[0]);
+}
+
 /*
 Avoid invalidating pointers to i_membrane_ unless the number of compartments
 in a thread has changed.
@@ -618,40 +686,46 @@ void nrn_fast_imem_alloc() {
 	}
 }
 
-void nrn_threads_free() {
-	int it, i;
-	for (it = 0; it < nrn_nthread; ++it) {
-		NrnThread* nt = nrn_threads + it;
-		NrnThreadMembList* tml, *tml2;
-		for (tml = nt->tml; tml; tml = tml2) {
-			Memb_list* ml = tml->ml;
-			tml2 = tml->next;
-			free((char*)ml->nodelist);
-			free((char*)ml->nodeindices);
-			if (memb_func[tml->index].hoc_mech) {
-				free((char*)ml->prop);
-			}else{
-				free((char*)ml->data);
-				free((char*)ml->pdata);
-			}
-			if (ml->_thread) {
-				if (memb_func[tml->index].thread_cleanup_) {
+static void thread_memblist_free(NrnThread* nt) {
+	int i;
+	NrnThreadMembList* tml, *tml2;
+	for (tml = nt->tml; tml; tml = tml2) {
+		Memb_list* ml = tml->ml;
+		tml2 = tml->next;
+		free((char*)ml->nodelist);
+		free((char*)ml->nodeindices);
+		if (memb_func[tml->index].hoc_mech) {
+			free((char*)ml->prop);
+		}else{
+			free((char*)ml->data);
+			free((char*)ml->pdata);
+		}
+		if (ml->_thread) {
+			if (memb_func[tml->index].thread_cleanup_) {
 	(*memb_func[tml->index].thread_cleanup_)(ml->_thread);
-				}
-				free((char*)ml->_thread);
 			}
-			free((char*)ml);
-			free((char*)tml);
+			free((char*)ml->_thread);
 		}
-		for (i=0; i < BEFORE_AFTER_SIZE; ++i) {
-			NrnThreadBAList* tbl, *tbl2;
-			for (tbl = nt->tbl[i]; tbl; tbl = tbl2) {
-				tbl2 = tbl->next;
-				free((char*)tbl);
-			}
-			nt->tbl[i] = (NrnThreadBAList*)0;
+		free((char*)ml);
+		free((char*)tml);
+	}
+	for (i=0; i < BEFORE_AFTER_SIZE; ++i) {
+		NrnThreadBAList* tbl, *tbl2;
+		for (tbl = nt->tbl[i]; tbl; tbl = tbl2) {
+			tbl2 = tbl->next;
+			free((char*)tbl);
 		}
-		nt->tml = (NrnThreadMembList*)0;
+		nt->tbl[i] = (NrnThreadBAList*)0;
+	}
+	nt->tml = (NrnThreadMembList*)0;
+	nt->_ecell_memb_list = 0;
+}
+
+void nrn_threads_free() {
+	int it;
+	for (it = 0; it < nrn_nthread; ++it) {
+		NrnThread* nt = nrn_threads + it;
+		thread_memblist_free(nt);
 		if (nt->userpart == 0 && nt->roots) {
 			hoc_l_freelist(&nt->roots);
 			nt->ncell = 0;
@@ -663,7 +737,6 @@ void nrn_threads_free() {
 		if (nt->_v_parent_index) {free((char*)nt->_v_parent_index); nt->_v_parent_index = 0;}
 		if (nt->_v_node) {free((char*)nt->_v_node); nt->_v_node = 0;}
 		if (nt->_v_parent) {free((char*)nt->_v_parent); nt->_v_parent = 0;}
-		nt->_ecell_memb_list = 0;
 		if (nt->_sp13mat) {
 			spDestroy(nt->_sp13mat);
 			nt->_sp13mat = 0;
@@ -820,6 +893,45 @@ static void nrn_thread_memblist_setup() {
 	nrn_fast_imem_alloc();
 	free((char*)vmap);
 	free((char*)mlcnt);
+	if (memb_stale_) { free(memb_stale_); }
+	memb_stale_ = (char*)ecalloc(nrn_nthread, sizeof(char));
+	nrn_mk_table_check();
+	if (nrn_mk_transfer_thread_data_) { (*nrn_mk_transfer_thread_data_)(); }
+}
+
+/*
+Rebuild the tml and tbl lists of only those threads in which a mechanism
+was inserted or removed (v_structure_change == 2). The nodes, their
+order, and the _actual_ arrays are unchanged so no node pointer needs
+updating, except that a newly located POINT_PROCESS area pointer still
+refers to the Node instead of _actual_area.
+*/
+static void nrn_thread_memblist_update() {
+	int it, i, *mlcnt;
+	void** vmap;
+	NrnThreadMembList* tml;
+	mlcnt = (int*)emalloc(n_memb_func*sizeof(int));
+	vmap = (void**)emalloc(n_memb_func*sizeof(void*));
+	for (it=0; it < nrn_nthread; ++it) if (memb_stale_[it]) {
+		NrnThread* nt = nrn_threads + it;
+		thread_memblist_free(nt);
+		thread_memblist_setup(nt, mlcnt, vmap);
+		if (nt->_actual_area) {
+			for (tml = nt->tml; tml; tml = tml->next)
+			  if (memb_func[tml->index].is_point) {
+				Memb_list* ml = tml->ml;
+				for (i=0; i < ml->nodecount; ++i) {
+	ml->pdata[i][0].pval = nt->_actual_area + ml->nodeindices[i];
+				}
+			}
+			/* the new property data is laid out by the next
+			   nrn_cache_prop_update() */
+			cache_prop_stale_ = 1;
+		}
+		memb_stale_[it] = 0;
+	}
+	free((char*)vmap);
+	free((char*)mlcnt);
 	nrn_mk_table_check();
 	if (nrn_mk_transfer_thread_data_) { (*nrn_mk_transfer_thread_data_)(); }
 }
@@ -887,7 +999,9 @@ static void reorder_secorder() {
 		sec->order = -1;
 	}
 	order = 0;
+	thread_sec_begin_ = (int*)erealloc(thread_sec_begin_, (nrn_nthread + 1)*sizeof(int));
 	FOR_THREADS(_nt) {
+		thread_sec_begin_[_nt->id] = order;
 		/* roots of this thread */
 		sl = _nt->roots;
 		inode = 0;
@@ -930,6 +1044,7 @@ static void reorder_secorder() {
 		}
 		_nt->end = inode;
 	}
+	thread_sec_begin_[nrn_nthread] = order;
 	assert(order == section_count);
 	/*assert(inode == v_node_count);*/
 	/* not missing any */
@@ -1065,6 +1180,92 @@ void nrn_multithread_job(void*(*job)(NrnThread*)) {
 }
 
 
+/* Point to point ordering within a single nrn_multithread_job.
+   A job that would otherwise be split in two because some threads read
+   values that other threads compute in the first part can instead call
+   nrn_thread_publish(nt) when its values are ready and nrn_thread_await(id)
+   before reading values owned by thread id. The caller brackets the job
+   with nrn_thread_publish_begin() and nrn_thread_publish_end(). The
+   former returns 0 if the threads do not run concurrently, in which case
+   the job must be split as before. Outside the bracket, nrn_thread_await
+   returns immediately.
+*/
+#define EPOCH_STRIDE 16 /* one cache line per thread */
+static volatile unsigned int* thread_epoch_;
+static int thread_epoch_size_;
+static unsigned int epoch_;
+static int epoch_active_;
+
+int nrn_thread_publish_begin() {
+#if USE_PTHREAD
+	if (!nrn_thread_parallel_ || nrn_nthread < 2) {
+		return 0;
+	}
+	if (thread_epoch_size_ < nrn_nthread) {
+		if (thread_epoch_) {
+			free((void*)thread_epoch_);
+		}
+		thread_epoch_ = (volatile unsigned int*)ecalloc(
+			nrn_nthread * EPOCH_STRIDE, sizeof(unsigned int));
+		thread_epoch_size_ = nrn_nthread;
+	}
+	++epoch_;
+	epoch_active_ = 1;
+	return 1;
+#else
+	return 0;
+#endif
+}
+
+void nrn_thread_publish_end() {
+	epoch_active_ = 0;
+}
+
+int nrn_thread_publish_active() {
+	return epoch_active_;
+}
+
+void nrn_thread_publish(NrnThread* nt) {
+#if USE_PTHREAD
+	if (epoch_active_) {
+		__sync_synchronize(); /* prior writes visible before the epoch */
+		thread_epoch_[nt->id * EPOCH_STRIDE] = epoch_;
+	}
+#endif
+}
+
+void nrn_thread_await(int id) {
+#if USE_PTHREAD
+	if (epoch_active_) {
+		while (thread_epoch_[id * EPOCH_STRIDE] != epoch_) {
+			sched_yield();
+		}
+		__sync_synchronize();
+	}
+#endif
+}
+
+/* Vector bulk operations (ivocvect.cpp) split long loops among the
+   threads. Returns 0 if the job cannot be run concurrently, otherwise
+   the number of threads, which is all a null job asks for.
+*/
+static void (*vec_job_)(int, int);
+static void* vec_job(NrnThread* nt) {
+	(*vec_job_)(nt->id, nrn_nthread);
+	return (void*)0;
+}
+
+static int nrn_vec_multithread(void (*job)(int, int)) {
+	if (!nrn_thread_parallel_ || nrn_inthread_ || nrn_nthread < 2) {
+		return 0;
+	}
+	if (job) {
+		vec_job_ = job;
+		nrn_multithread_job(vec_job);
+	}
+	return nrn_nthread;
+}
+
 void nrn_onethread_job(int i, void*(*job)(NrnThread*)) {
 	BENCHDECLARE
 	assert(i >= 0 && i < nrn_nthread);
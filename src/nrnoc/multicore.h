@@ -59,6 +59,7 @@ typedef struct NrnThread {
 	int end;    /* 1 + position of last in v_node array. Now v_node_count. */
 	int id; /* this is nrn_threads[id] */
 	int _stop_stepping; /* delivered an all thread HocEvent */
+	int _fused_jacob; /* nrn_cur also adds the conductance to d */
 
 	double* _actual_rhs;
 	double* _actual_d;
@@ -89,11 +90,54 @@ extern NrnThread* nrn_threads;
 extern void nrn_thread_error(const char*);
 extern void nrn_multithread_job(void*(*)(NrnThread*));
 extern void nrn_onethread_job(int, void*(*)(NrnThread*));
+extern int nrn_thread_publish_begin();
+extern void nrn_thread_publish_end();
+extern int nrn_thread_publish_active();
+extern void nrn_thread_publish(NrnThread*);
+extern void nrn_thread_await(int);
 extern void nrn_wait_for_threads();
 extern void nrn_thread_table_check();
 
 #define FOR_THREADS(nt) for (nt = nrn_threads; nt < nrn_threads + nrn_nthread; ++nt)
 
+/*
+Per thread, per mechanism profiling of the simulation hot path.
+Accumulated clock ticks are in nrn_prof_[thread][kind*nrn_prof_ntype_ + type]
+and converted to seconds by ParallelContext.profile_time. The solve and
+event kinds use type 0. Event time includes the NET_RECEIVE time.
+*/
+#define NRN_PROF_CUR 0
+#define NRN_PROF_JACOB 1
+#define NRN_PROF_STATE 2
+#define NRN_PROF_BA 3
+#define NRN_PROF_NETRECEIVE 4
+#define NRN_PROF_SOLVE 5
+#define NRN_PROF_EVENTS 6
+#define NRN_PROF_NKIND 7
+
+extern int nrn_prof_on_;
+extern int nrn_prof_ntype_;
+extern int nrn_prof_nthread_;
+extern unsigned long long** nrn_prof_;
+extern void nrn_prof_alloc(int nthread, int ntype);
+extern void nrn_prof_stop();
+extern double nrn_prof_tick2sec();
+extern unsigned long long nrn_prof_ticks();
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define nrn_prof_clock() ((unsigned long long)__builtin_ia32_rdtsc())
+#else
+#define nrn_prof_clock() nrn_prof_ticks()
+#endif
+
+#define NRN_PROF_BEGIN(t0) if (nrn_prof_on_) { t0 = nrn_prof_clock(); }
+#define NRN_PROF_END(t0, nt, kind, type) if (nrn_prof_on_) { \
+	int _id = (nt)->id, _ty = (type); \
+	if (_id < nrn_prof_nthread_ && _ty < nrn_prof_ntype_) { \
+		nrn_prof_[_id][(kind)*nrn_prof_ntype_ + _ty] += nrn_prof_clock() - t0; \
+	} \
+}
+
 #if defined(__cplusplus)
 }
 #endif
@@ -15,6 +15,7 @@ extern void oc_restore_cabcode(int* a1, int* a2);
 extern void new_sections(Object* ob, Symbol* sym, hoc_Item** pitm, int size);
 extern void cable_prop_assign(Symbol* sym, double* pd, int op);
 extern void nrn_parent_info(Section* s);
+extern void nrn_connectsec(Section* sec, double d1, Section* parent, double d2);
 extern void nrn_relocate_old_points(Section* oldsec, Node* oldnode, Section* sec, Node* node);
 extern int nrn_at_beginning(Section* sec);
 extern void nrn_node_destruct1(Node*);
@@ -22,9 +23,15 @@ extern void mech_insert1(Section*, int);
 extern void extcell_2d_alloc(Section* sec);
 extern int nrn_is_ion(int);
 extern void single_prop_free(Prop*);
+extern void nrn_node_prop_free(Node*, Prop*);
+extern void nrn_memb_change(Node*, int);
 extern void prop_free(Prop**);
 extern int can_change_morph(Section*);
 extern void nrn_area_ri(Section* sec);
+extern void nrn_pt3dset(Section* sec, int n, double* x, double* y, double* z, double* d);
+extern Pt3dShare* nrn_pt3dshare(Section* sec);
+extern void nrn_pt3dshare_use(Section* sec, Pt3dShare* ps);
+extern void nrn_pt3dshare_unref(Pt3dShare* ps);
 extern void nrn_diam_change(Section*);
 extern void sec_free(hoc_Item*);
 extern int node_index(Section* sec, double x);
@@ -36,6 +43,7 @@ extern Node* node_ptr(Section* sec, double x, double* parea);
 extern double* nrn_vext_pd(Symbol* s, int indx, Node* nd);
 extern double* nrnpy_dprop(Symbol* s, int indx, Section* sec, short inode, int* err);
 extern void nrn_disconnect(Section*);
+extern void nrn_delete_section(Section*);
 extern void mech_uninsert1(Section* sec, Symbol* s);
 extern Object* nrn_sec2cell(Section*);
 extern int nrn_sec2cell_equals(Section*, Object*);
@@ -56,6 +64,7 @@ extern void ob_sec_access_push(hoc_Item*);
 extern void nrn_mk_prop_pools(int);
 extern void SectionList_reg(void);
 extern void SectionRef_reg(void);
+extern void CellLoader_reg(void);
 extern void modl_reg(void);
 extern void hoc_register_tolerance(int, HocStateTolerance*, Symbol***);
 extern void hoc_symbol_tolerance(Symbol*, double);
@@ -76,6 +85,7 @@ extern void clear_point_process_struct(Prop* p);
 extern void ext_con_coef(void);
 extern void nrn_multisplit_ptr_update(void);
 extern void nrn_cache_prop_realloc();
+extern void nrn_cache_prop_update(void);
 extern void nrn_use_daspk(int);
 extern void nrn_update_ps2nt(void);
 extern void _nrn_free_fornetcon(void**);
@@ -124,6 +134,7 @@ extern void recalc_diam(void);
 extern double nrn_call_mech_func(Symbol*, int narg, Prop*, int type);
 extern Prop* nrn_mechanism_check(int type, Section* sec, int inode);
 extern int nrn_use_fast_imem;
+extern int nrn_use_fused_jacob;
 extern void nrn_fast_imem_alloc();
 extern void nrn_calc_fast_imem(NrnThread*);
 
@@ -324,9 +324,7 @@ static void free_one_point(Point_process* pnt) /* must unlink from node property
 		}
 	}
 #if VECTORIZE
-	{ extern int v_structure_change;
-	  v_structure_change = 1;
-	}
+	nrn_memb_change(pnt->node, p->type);
 #endif
 	if (p->param) {
 		if (memb_func[p->type].destructor) {
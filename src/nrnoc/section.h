@@ -61,6 +61,7 @@ typedef struct Section {
 	short  pt3d_bsize; /* amount of allocated space for 3-d points */
 	struct Pt3d *pt3d; /* list of 3d points with diameter */
 	struct Pt3d *logical_connection; /* nil for legacy, otherwise specifies logical connection position (for translation) */
+	struct Pt3dShare *pt3d_share; /* nil unless pt3d is shared read only with other sections */
 #endif
 	struct Prop	*prop;	/* eg. length, etc. */
 } Section;
@@ -70,6 +71,17 @@ typedef struct Pt3d {
 	float x,y,z,d;	/* 3d point, microns */
 	double arc;
 } Pt3d;
+
+/* 3d points used by any number of sections, e.g. every instance of a cell
+   built by a CellLoader. A section that modifies its points first gets a
+   private copy. Also caches the area and ri integrals for each nseg in use.
+*/
+typedef struct Pt3dShare {
+	int refcount;
+	short npt3d;
+	struct Pt3d* pt3d;
+	struct Pt3dGeom* geom;
+} Pt3dShare;
 #endif
 
 #if METHOD3
@@ -460,6 +460,7 @@ Section* sec_alloc(void)
 	sec->pt3d_bsize = 0;
 	sec->pt3d = (Pt3d *)0;
 	sec->logical_connection = (Pt3d*)0;
+	sec->pt3d_share = (Pt3dShare*)0;
 #endif
 	sec->prop = (Prop *)0;
 	sec->recalc_area_ = 0;
@@ -497,7 +498,12 @@ void sec_free(hoc_Item* secitem)
 		nrn_node_destruct1(sec->parentnode);
 	}
 #if DIAMLIST
-	if (sec->pt3d) {
+	if (sec->pt3d_share) {
+		nrn_pt3dshare_unref(sec->pt3d_share);
+		sec->pt3d_share = (Pt3dShare*)0;
+		sec->pt3d = (Pt3d*)0;
+		sec->npt3d = 0;
+	}else if (sec->pt3d) {
 		free((char *)sec->pt3d);
 		sec->pt3d = (Pt3d*)0;
 		sec->npt3d = 0;
@@ -6,6 +6,7 @@
 #include	<stdlib.h>
 #endif
 #include	<errno.h>
+#include	<string.h>
 #include	<math.h>
 #include	"section.h"
 #include	"membfunc.h"
@@ -61,18 +62,37 @@ int nrn_matrix_cnt_ = 0;
 int use_sparse13 = 0;
 int nrn_use_daspk_ = 0;
 
+/*
+When nonzero, setup_tree_matrix lets the nrn_cur of mechanisms registered with
+hoc_register_fused_jacob add their conductance to d in the same pass
+that computes the rhs. Their nrn_jacob is then skipped by nrn_lhs.
+Only for the tree matrix without extracellular. See cvode.use_fused_jacob().
+*/
+int nrn_use_fused_jacob;
+
 #if VECTORIZE
 /*
 When properties are allocated to nodes or freed, v_structure_change is
 set to 1. This means that the mechanism vectors need to be re-determined.
+If the only changes since the last v_setup_vectors are mechanisms inserted
+into or removed from nodes that already belong to a thread, it is set to 2
+instead and only the Memb_lists of the threads flagged in memb_stale_
+are rebuilt. See nrn_memb_change. Creating or deleting sections, e.g.
+adding or removing a cell, sets tree_changed and always takes the full
+path since the thread partition and node order depend on every root.
 */
 int v_structure_change;
+static char* memb_stale_; /* nrn_nthread flags, valid when v_structure_change==2 */
+static int cache_prop_stale_; /* see nrn_cache_prop_update */
 int structure_change_cnt;
 int diam_change_cnt;
 
 #endif
 extern int section_count;
 extern Section** secorder;
+/* secorder[thread_sec_begin_[i] ... thread_sec_begin_[i+1]-1] are the
+   sections of nrn_threads[i]. Filled by reorder_secorder. */
+static int* thread_sec_begin_;
 #if 1 /* if 0 then handled directly to save space : see finitialize*/
 extern short* nrn_is_artificial_;
 extern Template** nrn_pnt_template_;
@@ -345,6 +365,7 @@ void nrn_rhs(NrnThread* _nt) {
 	int i, i1, i2, i3;
 	double w;
 	int measure = 0;
+	unsigned long long t0;
 	NrnThreadMembList* tml;
 	
 	i1 = 0;
@@ -366,14 +387,29 @@ void nrn_rhs(NrnThread* _nt) {
 	}else{
 #if CACHEVEC
 	    if (use_cachevec) {
-		for (i = i1; i < i3; ++i) {
-			VEC_RHS(i) = 0.;
+		if (_nt->_fused_jacob) {
+			for (i = i1; i < i3; ++i) {
+				VEC_RHS(i) = 0.;
+				VEC_D(i) = 0.;
+			}
+		}else{
+			for (i = i1; i < i3; ++i) {
+				VEC_RHS(i) = 0.;
+			}
 		}
 	    }else
 #endif /* CACHEVEC */
 	    {
-		for (i = i1; i < i3; ++i) {
-			NODERHS(_nt->_v_node[i]) = 0.;
+		if (_nt->_fused_jacob) {
+			for (i = i1; i < i3; ++i) {
+				Node* nd = _nt->_v_node[i];
+				NODERHS(nd) = 0.;
+				NODED(nd) = 0.;
+			}
+		}else{
+			for (i = i1; i < i3; ++i) {
+				NODERHS(_nt->_v_node[i]) = 0.;
+			}
 		}
 	    }
 	}
@@ -381,6 +417,11 @@ void nrn_rhs(NrnThread* _nt) {
 		for (i = i1; i < i3; ++i) {
 			_nt->_nrn_fast_imem->_nrn_sav_rhs[i] = 0.;
 		}
+		if (_nt->_fused_jacob) {
+			for (i = i1; i < i3; ++i) {
+				_nt->_nrn_fast_imem->_nrn_sav_d[i] = 0.;
+			}
+		}
 	}
 
 	nrn_ba(_nt, BEFORE_BREAKPOINT);
@@ -388,7 +429,9 @@ void nrn_rhs(NrnThread* _nt) {
 	for (tml = _nt->tml; tml; tml = tml->next) if (memb_func[tml->index].current) {
 		Pvmi s = memb_func[tml->index].current;
 		if (measure) { w = nrnmpi_wtime(); }
+		NRN_PROF_BEGIN(t0)
 		(*s)(_nt, tml->ml, tml->index);
+		NRN_PROF_END(t0, _nt, NRN_PROF_CUR, tml->index)
 		if (measure) { nrn_mech_wtime_[tml->index] += nrnmpi_wtime() - w; }
 		if (errno) {
 			if (nrn_errno_check(tml->index)) {
@@ -466,6 +509,7 @@ This is a common operation for fixed step, cvode, and daspk methods
 
 void nrn_lhs(NrnThread* _nt) {
 	int i, i1, i2, i3;
+	unsigned long long t0;
 	NrnThreadMembList* tml;
 
 	i1 = 0;
@@ -480,7 +524,7 @@ void nrn_lhs(NrnThread* _nt) {
 		int i, neqn;
 		neqn = spGetSize(_nt->_sp13mat, 0);
 		spClear(_nt->_sp13mat);
-	}else{
+	}else if (!_nt->_fused_jacob) { /* else zeroed by nrn_rhs */
 #if CACHEVEC
 	    if (use_cachevec) {
 		for (i = i1; i < i3; ++i) {
@@ -495,7 +539,7 @@ void nrn_lhs(NrnThread* _nt) {
 	    }
 	}
 
-	if (_nt->_nrn_fast_imem) {
+	if (_nt->_nrn_fast_imem && !_nt->_fused_jacob) {
 		for (i = i1; i < i3; ++i) {
 			_nt->_nrn_fast_imem->_nrn_sav_d[i] = 0.;
 		}
@@ -504,7 +548,12 @@ void nrn_lhs(NrnThread* _nt) {
 	/* note that CAP has no jacob */
 	for (tml = _nt->tml; tml; tml = tml->next) if (memb_func[tml->index].jacob) {
 		Pvmi s = memb_func[tml->index].jacob;
+		if (_nt->_fused_jacob && memb_func[tml->index].fused_jacob) {
+			continue; /* d already set by its nrn_cur */
+		}
+		NRN_PROF_BEGIN(t0)
 		(*s)(_nt, tml->ml, tml->index);
+		NRN_PROF_END(t0, _nt, NRN_PROF_JACOB, tml->index)
 		if (errno) {
 			if (nrn_errno_check(tml->index)) {
 hoc_warning("errno set during calculation of jacobian", (char*)0);
@@ -591,8 +640,11 @@ has taken effect
 
 /* for the fixed step method */
 void* setup_tree_matrix(NrnThread* _nt){
+	_nt->_fused_jacob = (nrn_use_fused_jacob && !use_sparse13
+		&& !_nt->_ecell_memb_list);
 	nrn_rhs(_nt);
 	nrn_lhs(_nt);
+	_nt->_fused_jacob = 0;
 	nrn_nonvint_block_current(_nt->end, _nt->_actual_rhs, _nt->id);
 	nrn_nonvint_block_conductance(_nt->end, _nt->_actual_d, _nt->id);
 	return (void*)0;
@@ -605,6 +657,7 @@ With current implementation, a chain of "needs" may not be in list order.
 */
 static Prop **current_prop_list; /* the one prop_alloc is working on
 					when need_memb is called */
+static Node* current_prop_node; /* and the node that list belongs to */
 static int disallow_needmemb = 0; /* point processes cannot use need_memb
 	when inserted at locations 0 or 1 */
 
@@ -652,7 +705,7 @@ Prop* need_memb(Symbol* sym)
 		current_prop_list = cpl;
 		m = need_memb(sym);
 	}else{
-		m = prop_alloc(current_prop_list, type, (Node*)0);
+		m = prop_alloc(current_prop_list, type, current_prop_node);
 	}
 	return m;
 }
@@ -670,9 +723,10 @@ Prop* prop_alloc(Prop** pp, int type, Node* nd) {
 		nrn_alloc_node_ = nd;
 	}
 #if VECTORIZE
-	v_structure_change = 1;
+	nrn_memb_change(nd, type);
 #endif
 	current_prop_list = pp;
+	current_prop_node = nd;
 	p = (Prop *)emalloc(sizeof(Prop));
 	p->type = type;
 	p->next = *pp;
@@ -708,6 +762,42 @@ void prop_free(Prop** pp)	/* free an entire property list */
 	}
 }
 
+#if VECTORIZE
+/*
+A property of the given type was, or is about to be, linked into or
+unlinked from nd->prop. Unless something else already requires a full
+v_setup_vectors, only the Memb_lists of nd's thread are stale.
+A nil nd (property not on a node), artificial cells, and extracellular
+(which changes the matrix structure) always require the full setup.
+*/
+void nrn_memb_change(Node* nd, int type) {
+	if (v_structure_change != 1 && !tree_changed && memb_stale_
+	    && nd && nd->_nt && !nrn_is_artificial_[type]
+#if EXTRACELLULAR
+	    && type != EXTRACELL
+#endif
+	) {
+		memb_stale_[nd->_nt->id] = 1;
+		v_structure_change = 2;
+	}else{
+		v_structure_change = 1;
+	}
+}
+#endif
+
+/* free a Prop that has just been unlinked from nd->prop */
+void nrn_node_prop_free(Node* nd, Prop* p) {
+#if VECTORIZE
+	int sc = v_structure_change;
+	int type = p->type;
+	single_prop_free(p);
+	v_structure_change = sc;
+	nrn_memb_change(nd, type);
+#else
+	single_prop_free(p);
+#endif
+}
+
 void single_prop_free(Prop* p)
 {
 	extern char* pnt_map;
@@ -742,18 +832,42 @@ sections */
 #undef PI
 #define PI	3.14159265358979323846
 
-static double diam_from_list(Section* sec, int inode, Prop* p, double rparent);
+/* trapezoidal integration state carried from one segment to the next */
+typedef struct Pt3dIntegral {
+	int j;
+	double x1, y1, ds;
+} Pt3dIntegral;
 
-int recalc_diam_count_, nrn_area_ri_nocount_, nrn_area_ri_count_;
-void nrn_area_ri(Section* sec) {
+/* the sums for one segment that depend only on the 3-d points */
+typedef struct Pt3dSeg {
+	double diam, area, rleft, rright;
+	int nspine;
+} Pt3dSeg;
+
+static void pt3d_integrate(Pt3d* pt3d, int npt, int nseg, int inode,
+	Pt3dIntegral* pi, Pt3dSeg* seg);
+static double diam_from_seg(Section* sec, int inode, Prop* p, double rparent,
+	Pt3dSeg* seg);
+static Pt3dSeg* pt3d_shared_segs(Section* sec);
+
+/*
+Fills NODEAREA and NODERINV of sec. Only touches sec and its nodes so it
+can be called concurrently for sections in different threads. Returns 1
+if a diam was 0 (it is then set to 1e-6 and the rest is not computed).
+*/
+static int area_ri(Section* sec) {
 	int j;
 	double ra, dx, diam, rright, rleft;
 	Prop* p;
 	Node* nd;
-	if (nrn_area_ri_nocount_ == 0) { ++nrn_area_ri_count_; }
 #if DIAMLIST
+	Pt3dIntegral pi;
+	Pt3dSeg seg, *shared = (Pt3dSeg*)0;
 	if (sec->npt3d) {
 		sec->prop->dparam[2].val = sec->pt3d[sec->npt3d - 1].arc;
+		if (sec->pt3d_share && sec->npt3d > 1) {
+			shared = pt3d_shared_segs(sec);
+		}
 	}
 #endif
 	ra = nrn_ra(sec);
@@ -774,7 +888,13 @@ void nrn_area_ri(Section* sec) {
      and NODEAREA and NODERINV are filled in. The right half of the segment
      resistance (MOhm) is returned.
   */
-			rright = diam_from_list(sec, j,  p, rright);
+			if (shared) {
+				rright = diam_from_seg(sec, j, p, rright, shared + j);
+			}else{
+				pt3d_integrate(sec->pt3d, sec->npt3d, sec->nnode - 1,
+					j, &pi, &seg);
+				rright = diam_from_seg(sec, j, p, rright, &seg);
+			}
 		}else
 #endif
 		{
@@ -784,7 +904,7 @@ void nrn_area_ri(Section* sec) {
 			diam = p->param[0];
 			if (diam <= 0.) {
 				p->param[0] = 1e-6;
-hoc_execerror(secname(sec), "diameter diam = 0. Setting to 1e-6");
+				return 1;
 			}
 			NODEAREA(nd) = PI*diam*dx;	/* um^2 */
 			UPDATE_VEC_AREA(nd);
@@ -799,6 +919,15 @@ hoc_execerror(secname(sec), "diameter diam = 0. Setting to 1e-6");
 	UPDATE_VEC_AREA(sec->pnode[j]);
 	NODERINV(sec->pnode[j]) = 1./rright;
 	sec->recalc_area_ = 0;
+	return 0;
+}
+
+int recalc_diam_count_, nrn_area_ri_nocount_, nrn_area_ri_count_;
+void nrn_area_ri(Section* sec) {
+	if (nrn_area_ri_nocount_ == 0) { ++nrn_area_ri_count_; }
+	if (area_ri(sec)) {
+hoc_execerror(secname(sec), "diameter diam = 0. Setting to 1e-6");
+	}
 	diam_changed = 1;
 }
 
@@ -806,38 +935,36 @@ Node* nrn_parent_node(Node* nd) {
 	return nd->_classical_parent;
 }
 
-void connection_coef(void)	/* setup a and b */
-{
-	int j;
-	double dx, diam, area, ra;
-	hoc_Item* qsec;
-	Node *nd;
-	Prop *p;
-#if RA_WARNING
-	extern int nrn_ra_set;
-#endif
-	
-#if 1
-	/* now only called from recalc_diam */
-	assert(!tree_changed);
-#else
-	if (tree_changed) {
-		setup_topology();
-	}
-#endif
+static Section** area_err_; /* per thread, first section with 0 diam */
 
-#if RA_WARNING
-	if (nrn_ra_set > 0 && nrn_ra_set < section_count - 1) {
-		hoc_warning("Don't forget to set Ra in every section",
-			"eg. forall Ra=35.4");
-	}
+/*
+Area, ri, a and b for the sections of one thread. Sections with 3-d points
+are integrated only if sec->recalc_area_ is set. Every change to their
+points, L, Ra, or nseg sets it, and a diam from the 3-d points overrides
+diam anyway. Cylinders are cheap and always recomputed since their diam
+may have been changed through a pointer.
+*/
+static void* connection_coef_thread(NrnThread* nt) {
+	int i, j, i0, i1;
+	double area;
+	Section* sec;
+	Node* nd;
+
+	i0 = thread_sec_begin_[nt->id];
+	i1 = thread_sec_begin_[nt->id + 1];
+	area_err_[nt->id] = (Section*)0;
+	for (i = i0; i < i1; ++i) {
+		sec = secorder[i];
+#if DIAMLIST
+		if (sec->npt3d > 1 && !sec->recalc_area_) {
+			continue;
+		}
 #endif
-	++recalc_diam_count_;
-	nrn_area_ri_nocount_ = 1;
-	ForAllSections(sec)
-		nrn_area_ri(sec);
+		if (area_ri(sec)) {
+			area_err_[nt->id] = sec;
+			return (void*)0;
+		}
 	}
-	nrn_area_ri_nocount_ = 0;
 	/* assume that if only one connection at x=1, then they butte
 	together, if several connections at x=1
 	then last point is at x=1, has 0 area and other points are at
@@ -846,7 +973,8 @@ void connection_coef(void)	/* setup a and b */
 	section connects straight to the point*/
 	/* for the near future we always have a last node at x=1 with
 	no properties */
-	ForAllSections(sec)
+	for (i = i0; i < i1; ++i) {
+		sec = secorder[i];
 #if 1 /* unnecessary because they are unused, but help when looking at fmatrix */
 		if (!sec->parentsec) {
 			if (nrn_classicalNodeA(sec->parentnode)) {
@@ -876,12 +1004,46 @@ void connection_coef(void)	/* setup a and b */
 		}
 	}
 	/* now the effect of parent on node equation. */
-	ForAllSections(sec)
+	for (i = i0; i < i1; ++i) {
+		sec = secorder[i];
 		for (j=0; j < sec->nnode; j++) {
 			nd = sec->pnode[j];
 			ClassicalNODEB(nd) = -1.e2 * NODERINV(nd) / NODEAREA(nd);
 		}
 	}
+	return (void*)0;
+}
+
+void connection_coef(void)	/* setup a and b */
+{
+	int i;
+#if RA_WARNING
+	extern int nrn_ra_set;
+#endif
+	
+#if 1
+	/* now only called from recalc_diam */
+	assert(!tree_changed);
+#else
+	if (tree_changed) {
+		setup_topology();
+	}
+#endif
+
+#if RA_WARNING
+	if (nrn_ra_set > 0 && nrn_ra_set < section_count - 1) {
+		hoc_warning("Don't forget to set Ra in every section",
+			"eg. forall Ra=35.4");
+	}
+#endif
+	++recalc_diam_count_;
+	/* each cell is entirely in one thread */
+	area_err_ = (Section**)erealloc(area_err_, nrn_nthread*sizeof(Section*));
+	nrn_multithread_job(connection_coef_thread);
+	for (i=0; i < nrn_nthread; ++i) if (area_err_[i]) {
+		diam_changed = 1;
+hoc_execerror(secname(area_err_[i]), "diameter diam = 0. Setting to 1e-6");
+	}
 #if EXTRACELLULAR
 	ext_con_coef();
 #endif
@@ -1020,7 +1182,96 @@ void pt3dclear(void) { /*destroys space in current section for 3d points.*/
 	hoc_retpushx((double)sec->pt3d_bsize);
 }
 
+/*
+Sharing of 3-d points. A shared array is never modified. Every function
+that changes a section's points first calls pt3d_own, which gives the
+section a private copy. The last reference frees the points and the
+cached integrals.
+*/
+typedef struct Pt3dGeom { /* integrals for one nseg */
+	int nseg;
+	struct Pt3dSeg* seg;
+	struct Pt3dGeom* next;
+} Pt3dGeom;
+
+extern void nrn_malloc_lock(void);
+extern void nrn_malloc_unlock(void);
+
+/* a new reference to the points of sec, which become shared */
+Pt3dShare* nrn_pt3dshare(Section* sec) {
+	Pt3dShare* ps = sec->pt3d_share;
+	if (!ps) {
+		if (sec->npt3d == 0) {
+			return (Pt3dShare*)0;
+		}
+		ps = (Pt3dShare*)emalloc(sizeof(Pt3dShare));
+		ps->refcount = 1;
+		ps->npt3d = sec->npt3d;
+		ps->pt3d = sec->pt3d;
+		ps->geom = (Pt3dGeom*)0;
+		sec->pt3d_share = ps;
+		sec->pt3d_bsize = 0;
+	}
+	++ps->refcount;
+	return ps;
+}
+
+void nrn_pt3dshare_unref(Pt3dShare* ps) {
+	Pt3dGeom* g;
+	int rc;
+	/* may be called from define_shape_thread */
+	nrn_malloc_lock();
+	rc = --ps->refcount;
+	nrn_malloc_unlock();
+	if (rc > 0) {
+		return;
+	}
+	while (ps->geom) {
+		g = ps->geom;
+		ps->geom = g->next;
+		free((char*)g->seg);
+		free((char*)g);
+	}
+	free((char*)ps->pt3d);
+	free((char*)ps);
+}
+
+/* replace the points of sec by the shared ps */
+void nrn_pt3dshare_use(Section* sec, Pt3dShare* ps) {
+	if (sec->pt3d_share == ps) {
+		return;
+	}
+	if (sec->pt3d_share) {
+		nrn_pt3dshare_unref(sec->pt3d_share);
+	}else if (sec->pt3d) {
+		free((char*)sec->pt3d);
+	}
+	++nrn_shape_changed_;
+	++ps->refcount;
+	sec->pt3d_share = ps;
+	sec->pt3d = ps->pt3d;
+	sec->npt3d = ps->npt3d;
+	sec->pt3d_bsize = 0;
+	/* what nrn_pt3dmodified does, the arc lengths are already there */
+	diam_changed = 1;
+	sec->recalc_area_ = 1;
+	sec->prop->dparam[2].val = sec->pt3d[sec->npt3d - 1].arc;
+}
+
+static void pt3d_own(Section* sec) {
+	Pt3dShare* ps = sec->pt3d_share;
+	if (ps) {
+		int n = sec->npt3d;
+		sec->pt3d = (Pt3d*)emalloc(n*sizeof(Pt3d));
+		memcpy(sec->pt3d, ps->pt3d, n*sizeof(Pt3d));
+		sec->pt3d_bsize = n;
+		sec->pt3d_share = (Pt3dShare*)0;
+		nrn_pt3dshare_unref(ps);
+	}
+}
+
 static void nrn_pt3dbufchk(Section* sec, int n) {
+	pt3d_own(sec);
 	if (n > sec->pt3d_bsize) {
 		sec->pt3d_bsize = n;
 		if ((sec->pt3d =
@@ -1033,19 +1284,25 @@ static void nrn_pt3dbufchk(Section* sec, int n) {
 	}
 }
 
+static void nrn_pt3darc(Section* sec, int i0);
+
 static void nrn_pt3dmodified(Section* sec, int i0) {
-	int n, i;
-	
 	++nrn_shape_changed_;
 	diam_changed = 1;
 	sec->recalc_area_ = 1;
-	n = sec->npt3d;
 #if NTS_SPINE
 #else
 	if (sec->pt3d[i0].d < 0.) {
 		hoc_execerror("Diameter less than 0", (char *)0);
 	}
 #endif
+	nrn_pt3darc(sec, i0);
+}
+
+/* arc lengths from point i0 on, and L */
+static void nrn_pt3darc(Section* sec, int i0) {
+	int n, i;
+	n = sec->npt3d;
 	if (i0 == 0) {
 		sec->pt3d[0].arc = 0.;
 		i0 = 1;
@@ -1070,6 +1327,12 @@ void nrn_pt3dclear(Section* sec)
 		req = 0;
 	}
 	++nrn_shape_changed_;
+	if (sec->pt3d_share) {
+		nrn_pt3dshare_unref(sec->pt3d_share);
+		sec->pt3d_share = (Pt3dShare*)0;
+		sec->pt3d = (Pt3d*)0;
+		sec->pt3d_bsize = 0;
+	}
 	if (req != sec->pt3d_bsize) {
 		if (sec->pt3d) {
 			free((char *)(sec->pt3d));
@@ -1112,6 +1375,7 @@ void pt3dchange(void) {
 	Section* sec = chk_access();
 	n = sec->npt3d;
 	i = (int)chkarg(1, 0., (double)(n-1));
+	pt3d_own(sec);
 	if (ifarg(5)) {
 		sec->pt3d[i].x = *getarg(2);
 		sec->pt3d[i].y = *getarg(3);
@@ -1131,6 +1395,7 @@ void pt3dremove(void) {
 	Section* sec = chk_access();
 	n = sec->npt3d;
 	i0 = (int)chkarg(1, 0., (double)(n-1));
+	pt3d_own(sec);
 	for (i=i0+1; i < n; ++i) {
 		Pt3d* p = sec->pt3d + i - 1;
 		p->x = sec->pt3d[i].x;
@@ -1152,6 +1417,7 @@ void nrn_diam_change(Section* sec)
 		if (fabs(L - sec->pt3d[sec->npt3d - 1].arc) > .001) {
 			nrn_length_change(sec, L);
 		}
+		pt3d_own(sec);
 		for (i=0; i < sec->npt3d; ++i) {
 			x = sec->pt3d[i].arc/L;
 			if (x > 1.0) {x = 1.0;}
@@ -1169,6 +1435,7 @@ void nrn_length_change(Section* sec, double d)
 		double x0,y0,z0;
 		double fac;
 		double l;
+		pt3d_own(sec);
 		x0 = sec->pt3d[0].x;
 		y0 = sec->pt3d[0].y;
 		z0 = sec->pt3d[0].z;
@@ -1193,12 +1460,13 @@ int can_change_morph(Section* sec)
 }
 	
 static void stor_pt3d_vec(Section* sec, IvocVect* xv, IvocVect* yv, IvocVect* zv, IvocVect* dv) {
+	nrn_pt3dset(sec, vector_capacity(xv), vector_vec(xv), vector_vec(yv),
+		vector_vec(zv), vector_vec(dv));
+}
+
+void nrn_pt3dset(Section* sec, int n, double* x, double* y, double* z, double* d) {
+	/* replaces all the 3-d points of sec with a single allocation */
 	int i;
-	int n = vector_capacity(xv);
-	double* x = vector_vec(xv);
-	double* y = vector_vec(yv);
-	double* z = vector_vec(zv);
-	double* d = vector_vec(dv);
 	nrn_pt3dbufchk(sec, n);
 	sec->npt3d = n;
 	for (i=0; i < n; i++) {
@@ -1311,8 +1579,12 @@ void stor_pt3d(Section* sec, double x, double y, double z, double d)
 static double spinearea=0.;
 
 void setSpineArea(void) {
+	hoc_Item* qsec;
 	spinearea = *getarg(1);
 	diam_changed = 1;
+	ForAllSections(sec) /* every 3-d point integral */
+		sec->recalc_area_ = 1;
+	}
 	hoc_retpushx(spinearea);
 }
 
@@ -1346,6 +1618,10 @@ static void nrn_translate_shape(Section* sec, float x, float y, float z)
 		dz = z - sec->pt3d[0].z;
 	}
 /*	if (dx*dx + dy*dy + dz*dz < 10.)*/
+	if (dx == 0. && dy == 0. && dz == 0.) {
+		return;
+	}
+	pt3d_own(sec);
 	for (i=0; i < sec->npt3d; ++i) {
 		sec->pt3d[i].x += dx;
 		sec->pt3d[i].y += dy;
@@ -1353,20 +1629,38 @@ static void nrn_translate_shape(Section* sec, float x, float y, float z)
 	}
 }
 
-void nrn_define_shape(void) {
-	static int changed_;
+/* append a 3-d point without the global side effects of stor_pt3d */
+static void define_shape_pt3d(Section* sec, double x, double y, double z, double d)
+{
+	int n;
+	
+	n = sec->npt3d;
+	nrn_pt3dbufchk(sec, n+1);
+	sec->npt3d++;			
+	sec->pt3d[n].x = x;
+	sec->pt3d[n].y = y;
+	sec->pt3d[n].z = z;
+	sec->pt3d[n].d = d;
+	sec->recalc_area_ = 1;
+	nrn_pt3darc(sec, n);
+}
+
+static int* define_shape_stored_; /* per thread, 3-d points were created */
+
+/*
+A section's position depends only on its parent so each thread does
+the sections of its own cells, in secorder.
+*/
+static void* define_shape_thread(NrnThread* nt) {
 	int i, j;
-	Section* sec, *psec, *ch, *nrn_trueparent();
+	Section* sec, *psec, *ch;
 	float x, y, z, dz, x1, y1;
 	float nch, ich=0.0, angle;
 	double arc, len;
 	double nrn_connection_position();
-	if (changed_ == nrn_shape_changed_ && !diam_changed && !tree_changed) {
-		return;
-	}
-	recalc_diam();
 	dz = 100.;
-	for (i=0; i < section_count; ++i) {
+	define_shape_stored_[nt->id] = 0;
+	for (i=thread_sec_begin_[nt->id]; i < thread_sec_begin_[nt->id + 1]; ++i) {
 		sec = secorder[i];
 		arc = nrn_connection_position(sec);
 		if ((psec = sec->parentsec) == (Section*)0) {
@@ -1421,27 +1715,46 @@ printf("nrn_define_shape: %s first and last 3-d point at same (x,y)\n", secname(
 		len = section_length(sec);
 		x1 = x + len*cos(angle);
 		y1 = y + len*sin(angle);
-		stor_pt3d(sec, x, y, z, nrn_diameter(sec->pnode[0]));
+		define_shape_pt3d(sec, x, y, z, nrn_diameter(sec->pnode[0]));
 		for (j = 0; j < sec->nnode-1; ++j) {
 			double frac = ((double)j+.5)/(double)(sec->nnode-1);
-			stor_pt3d(sec,
+			define_shape_pt3d(sec,
 				x*(1-frac)+x1*frac,
 				y*(1-frac)+y1*frac,
 				z,
 				nrn_diameter(sec->pnode[j])
 			);
 		}
-		stor_pt3d(sec, x1, y1, z, nrn_diameter(sec->pnode[sec->nnode-2]));
+		define_shape_pt3d(sec, x1, y1, z, nrn_diameter(sec->pnode[sec->nnode-2]));
 		/* don't let above change length due to round-off errors*/
 		sec->pt3d[sec->npt3d-1].arc = len;		
 		sec->prop->dparam[2].val = len;
+		define_shape_stored_[nt->id] = 1;
+	}
+	return (void*)0;
+}
+
+void nrn_define_shape(void) {
+	static int changed_;
+	int i;
+	if (changed_ == nrn_shape_changed_ && !diam_changed && !tree_changed) {
+		return;
+	}
+	recalc_diam();
+	define_shape_stored_ = (int*)erealloc(define_shape_stored_, nrn_nthread*sizeof(int));
+	nrn_multithread_job(define_shape_thread);
+	for (i=0; i < nrn_nthread; ++i) if (define_shape_stored_[i]) {
+		/* what stor_pt3d would have done */
+		++nrn_shape_changed_;
+		diam_changed = 1;
+		break;
 	}
 	changed_ = nrn_shape_changed_;
 }
 
-static double diam_from_list(Section* sec, int inode, Prop* p, double rparent)
-	/* p->param[0] is diam of inode in sec.*/
-	/* rparent right half resistance of the parent segment*/
+static void pt3d_integrate(Pt3d* pt3d, int npt, int nseg, int inode,
+	Pt3dIntegral* pi, Pt3dSeg* seg)
+	/* pi carries the position in the 3-d points to the next inode */
 {
 	/* Basic algorithm assumes a set of monotonic points on which a
 	   function is defined. The extension is the piecewise continuous
@@ -1454,29 +1767,30 @@ static double diam_from_list(Section* sec, int inode, Prop* p, double rparent)
 	/* computes diam as average, area, and ri. Slightly weirder since
 	   interval spit in two to compute right and left half values of ri
 	*/
-	/* fills NODEAREA and NODERINV and returns the right half resistance
-	   (MOhms) of the segment.
+	/* fills seg with the sums, which depend only on the 3-d points, for
+	   segment inode. See diam_from_seg.
 	*/
-	static int j;
-	static double x1, y1, ds;
+	int j;
+	double x1, y1, ds;
 	int ihalf;
 	double si, sip;
-	double diam, delta, temp, ri, area, ra, rleft=0.0;
-	int npt, nspine;
+	double diam, delta, temp, ri, area;
+	int nspine;
 
 	if (inode == 0) {
-		j = 0;
-		si = 0.;
-		x1 = sec->pt3d[j].arc;
-		y1 = fabs(sec->pt3d[j].d);
-		ds = sec->pt3d[sec->npt3d - 1].arc / ((double)(sec->nnode - 1));
-	}
+		pi->j = 0;
+		pi->x1 = pt3d[0].arc;
+		pi->y1 = fabs(pt3d[0].d);
+		pi->ds = pt3d[npt - 1].arc / ((double)nseg);
+	}
+	j = pi->j;
+	x1 = pi->x1;
+	y1 = pi->y1;
+	ds = pi->ds;
 	si = (double)inode*ds;
-	npt = sec->npt3d;
 	diam = 0.;
 	area = 0.;
 	nspine = 0;
-	ra = nrn_ra(sec);
     for (ihalf = 0; ihalf < 2; ihalf++) {
 	ri = 0.;
     	sip = si + ds/2.;
@@ -1484,13 +1798,13 @@ static double diam_from_list(Section* sec, int inode, Prop* p, double rparent)
 		int jp, jnext;
 		double x2, y2, xj, xjp;
 		jp = j + 1;
-		xj = sec->pt3d[j].arc;
+		xj = pt3d[j].arc;
 #if NTS_SPINE
-		if (sec->pt3d[j].d < 0 && xj >= si && xj < sip) {
+		if (pt3d[j].d < 0 && xj >= si && xj < sip) {
 			nspine++;
 		}
 #endif
-		xjp = sec->pt3d[jp].arc;
+		xjp = pt3d[jp].arc;
 		if (xjp > sip || jp == npt - 1) {
 			double frac;
 			if (fabs(xjp - xj) < 1e-10) {
@@ -1499,11 +1813,11 @@ static double diam_from_list(Section* sec, int inode, Prop* p, double rparent)
 				frac = (sip - xj)/(xjp - xj);
 			}
 			x2 = sip;
-			y2 = (1. - frac)*fabs(sec->pt3d[j].d) + frac*fabs(sec->pt3d[jp].d);
+			y2 = (1. - frac)*fabs(pt3d[j].d) + frac*fabs(pt3d[jp].d);
 			jnext = j;
 		}else{
 			x2 = xjp;
-			y2 = fabs(sec->pt3d[jp].d);
+			y2 = fabs(pt3d[jp].d);
 			jnext = jp;
 		}
 
@@ -1535,32 +1849,85 @@ static double diam_from_list(Section* sec, int inode, Prop* p, double rparent)
 		j = jnext;
 	}
 	if (ihalf == 0) {
-		rleft = ri*ra/PI*(4.*.01); /*left seg resistance*/
+		seg->rleft = ri;
 	}else{
-		ri = ri*ra/PI*(4.*.01);	/* MegOhms */
-		/* above is right half segment resistance */
+		seg->rright = ri;
 	}
 	si = sip;
     }
+	pi->j = j;
+	pi->x1 = x1;
+	pi->y1 = y1;
+	seg->diam = diam;
+	seg->area = area;
+#if NTS_SPINE
+	/* if last point has a spine then increment spine count for last node */
+	if (inode == nseg-1 && pt3d[npt-1].d < 0.) {
+		nspine += 1;
+	}
+#endif
+	seg->nspine = nspine;
+}
+
+static double diam_from_seg(Section* sec, int inode, Prop* p, double rparent,
+	Pt3dSeg* seg)
+	/* p->param[0] is diam of inode in sec.*/
+	/* rparent right half resistance of the parent segment*/
+	/* fills NODEAREA and NODERINV and returns the right half resistance
+	   (MOhms) of the segment.
+	*/
+{
+	double diam, ri, ds, ra, rleft;
+	ds = sec->pt3d[sec->npt3d - 1].arc / ((double)(sec->nnode - 1));
+	ra = nrn_ra(sec);
+	rleft = seg->rleft*ra/PI*(4.*.01); /*left seg resistance*/
+	ri = seg->rright*ra/PI*(4.*.01);	/* MegOhms */
+	/* above is right half segment resistance */
 	/* answer for inode is here */
 	NODERINV(sec->pnode[inode]) = 1./(rparent + rleft);
+	diam = seg->diam;
 	diam *= .5/ds;
 	if (fabs(diam - p->param[0]) > 1e-9 || diam < 1e-5) {
 		p->param[0] = diam;	/* microns */
 	}
-	NODEAREA(sec->pnode[inode]) = area*.5*PI;/* microns^2 */
+	NODEAREA(sec->pnode[inode]) = seg->area*.5*PI;/* microns^2 */
 	UPDATE_VEC_AREA(sec->pnode[inode]);
 #if NTS_SPINE
-	/* if last point has a spine then increment spine count for last node */
-	if (inode == sec->nnode-2 && sec->pt3d[npt-1].d < 0.) {
-		nspine += 1;
-	}
-	NODEAREA(sec->pnode[inode]) += nspine*spinearea;
+	NODEAREA(sec->pnode[inode]) += seg->nspine*spinearea;
 	UPDATE_VEC_AREA(sec->pnode[inode]);
 #endif
 	return ri;
 }
 
+/*
+The integrals for shared points with the nseg of sec. Computed by the
+first section that needs them, possibly from several threads at once.
+*/
+static Pt3dSeg* pt3d_shared_segs(Section* sec) {
+	Pt3dShare* ps = sec->pt3d_share;
+	Pt3dGeom* g;
+	Pt3dIntegral pi;
+	int j, nseg = sec->nnode - 1;
+	nrn_malloc_lock();
+	for (g = ps->geom; g; g = g->next) {
+		if (g->nseg == nseg) {
+			break;
+		}
+	}
+	if (!g) {
+		g = (Pt3dGeom*)emalloc(sizeof(Pt3dGeom));
+		g->nseg = nseg;
+		g->seg = (Pt3dSeg*)emalloc(nseg*sizeof(Pt3dSeg));
+		for (j = 0; j < nseg; ++j) {
+			pt3d_integrate(ps->pt3d, ps->npt3d, nseg, j, &pi, g->seg + j);
+		}
+		g->next = ps->geom;
+		ps->geom = g;
+	}
+	nrn_malloc_unlock();
+	return g->seg;
+}
+
 #endif /*DIAMLIST*/
 
 #include "multicore.c"
@@ -1583,6 +1950,16 @@ void v_setup_vectors(void) {
 	if (!v_structure_change) {
 		return;
 	}
+	if (v_structure_change == 2) {
+		/* only mechanisms in existing nodes changed */
+		nrn_thread_memblist_update();
+		v_structure_change = 0;
+		nrn_update_ps2nt();
+		++structure_change_cnt;
+		long_difus_solve(3, nrn_threads);
+		nrn_nonvint_block_setup();
+		return;
+	}
 
 	nrn_threads_free();
 
@@ -2215,8 +2592,26 @@ void nrn_recalc_node_ptrs(void) {
 	old_actual_area_ = 0;
 	n_old_thread_ = 0;
 
+	cache_prop_stale_ = 0;
 	nrn_cache_prop_realloc();
 	nrn_recalc_ptrvector();
 }
 
 #endif /* CACHEVEC */
+
+/*
+nrn_thread_memblist_update does not relayout the property data of every
+mechanism on each incremental change. The cache efficient layout is
+completed here, just before a simulation needs it.
+*/
+void nrn_cache_prop_update(void) {
+#if CACHEVEC && VECTORIZE
+	if (cache_prop_stale_) {
+		cache_prop_stale_ = 0;
+		if (use_cachevec) {
+			nrn_cache_prop_realloc();
+			nrn_recalc_ptrvector();
+		}
+	}
+#endif
+}
@@ -47,14 +47,21 @@ Object* nrnpy_po2ho(PyObject*);
 extern Object* nrnpy_pyobject_in_obj(PyObject*);
 static void pyobject_in_objptr(Object**, PyObject*);
 extern IvocVect* (*nrnpy_vec_from_python_p_)(void*);
+extern IvocVect* (*nrnpy_vec_from_buffer_p_)(void*);
 extern Object** (*nrnpy_vec_to_python_p_)(void*);
 extern Object** (*nrnpy_vec_as_numpy_helper_)(int, double*);
 int nrnpy_set_vec_as_numpy(PyObject* (*p)(int, double*));  // called by ctypes.
 extern double** nrnpy_setpointer_helper(PyObject*, PyObject*);
 extern Symbol* ivoc_alias_lookup(const char* name, Object* ob);
 extern int nrn_netcon_weight(void*, double**);
+extern double* matrix_pelm(void*, int i, int j);
+extern int matrix_nrow(void*);
+extern int matrix_ncol(void*);
+extern int matrix_type(void*);
+extern void matrix_export(void*, int incr);
 
 static cTemplate* hoc_vec_template_;
+static cTemplate* hoc_matrix_template_;
 static cTemplate* hoc_list_template_;
 static cTemplate* hoc_sectionlist_template_;
 
@@ -133,6 +140,7 @@ typedef struct {
 } PyHocObject;
 
 static PyTypeObject* hocobject_type;
+static PyTypeObject* hocbuffer_type;
 static PyObject* hocobj_call(PyHocObject* self, PyObject* args,
                              PyObject* kwrds);
 
@@ -174,6 +182,23 @@ static void hocobj_dealloc(PyHocObject* self) {
   ((PyObject*)self)->ob_type->tp_free((PyObject*)self);
 }
 
+// Python type for the hoc object. Only Vector and full Matrix support the
+// buffer protocol, so only they get the HocObject subtype that has it.
+// Otherwise PyObject_CheckBuffer would be true for every hoc object.
+static PyTypeObject* hocobj_pytype(Object* ho) {
+  if (ho->ctemplate == hoc_vec_template_ ||
+      (ho->ctemplate == hoc_matrix_template_ &&
+       matrix_type(ho->u.this_pointer) == 1)) {
+    return hocbuffer_type;
+  }
+  return hocobject_type;
+}
+
+// true if po is an instance of a Python subclass of HocObject
+static int hocobj_pysub(PyObject* po) {
+  return po->ob_type != hocobject_type && po->ob_type != hocbuffer_type;
+}
+
 static PyObject* hocobj_new(PyTypeObject* subtype, PyObject* args,
                             PyObject* kwds) {
   PyObject* subself;
@@ -434,7 +459,7 @@ PyObject* nrnpy_ho2po(Object* o) {
     po = nrnpy_hoc2pyobject(o);
     Py_INCREF(po);
   } else {
-    po = hocobj_new(hocobject_type, 0, 0);
+    po = hocobj_new(hocobj_pytype(o), 0, 0);
     ((PyHocObject*)po)->ho_ = o;
     ((PyHocObject*)po)->type_ = PyHoc::HocObject;
     hoc_obj_ref(o);
@@ -560,7 +585,7 @@ static void* fcall(void* vself, void* vargs) {
     hoc_pushx(d);
   } else if (self->sym_->type == TEMPLATE) {
     Object* ho = hoc_newobj1(self->sym_, narg);
-    PyHocObject* result = (PyHocObject*)hocobj_new(hocobject_type, 0, 0);
+    PyHocObject* result = (PyHocObject*)hocobj_new(hocobj_pytype(ho), 0, 0);
     result->ho_ = ho;
     result->type_ = PyHoc::HocObject;
     return result;
@@ -1052,7 +1077,7 @@ static PyObject* hocobj_baseattr(PyObject* subself, PyObject* args) {
 static int refuse_to_look;
 static PyObject* hocobj_getattro(PyObject* subself, PyObject* name) {
   PyObject* result = 0;
-  if ((PyTypeObject*)PyObject_Type(subself) != hocobject_type) {
+  if (hocobj_pysub(subself)) {
     // printf("try generic %s\n", PyString_AsString(name));
     result = PyObject_GenericGetAttr(subself, name);
     if (result) {
@@ -1074,7 +1099,7 @@ static int hocobj_setattro(PyObject* subself, PyObject* pyname,
   Inst* pcsav;
   Inst fc;
 
-  int issub = ((PyTypeObject*)PyObject_Type(subself) != hocobject_type);
+  int issub = hocobj_pysub(subself);
   if (issub) {
     // printf("try hasattr %s\n", PyString_AsString(name));
     refuse_to_look = 1;
@@ -1769,6 +1794,77 @@ static char* double_array_interface(PyObject* po, long& stride) {
   return (char*)data;
 }
 
+// true if po exports a buffer of double (native byte order) elements.
+// PyBuffer_Release(view) when done. Does not leave a Python error set.
+bool nrnpy_double_buffer(PyObject* po, Py_buffer* view, int flags) {
+  if (!PyObject_CheckBuffer(po)) {
+    return false;
+  }
+  if (PyObject_GetBuffer(po, view, flags | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    return false;
+  }
+  const char* f = view->format;
+  if (f && (*f == '@' || *f == '=' || *f == array_interface_typestr[0])) {
+    ++f;
+  }
+  if (!f || strcmp(f, "d") != 0 || view->itemsize != sizeof(double)
+      || (view->ndim > 1 && !PyBuffer_IsContiguous(view, 'C'))) {
+    PyBuffer_Release(view);
+    return false;
+  }
+  return true;
+}
+
+// copy the elements of a double buffer to the Vector. One memcpy when
+// the buffer is contiguous.
+static void vec_from_double_buffer(Vect* hv, Py_buffer* view) {
+  int size = int(view->len / sizeof(double));
+  hv->resize(size);
+  double* x = vector_vec(hv);
+  if (PyBuffer_IsContiguous(view, 'C')) {
+    memcpy(x, view->buf, size * sizeof(double));
+  } else {  // nrnpy_double_buffer allows strides only for ndim 1
+    char* y = (char*)view->buf;
+    for (int i = 0; i < size; ++i, y += view->strides[0]) {
+      x[i] = *(double*)y;
+    }
+  }
+}
+
+// one memcpy into a writable contiguous double buffer of the same size
+static bool vec_to_double_buffer(Vect* hv, PyObject* po) {
+  Py_buffer view;
+  bool copied = false;
+  if (nrnpy_double_buffer(po, &view, PyBUF_WRITABLE | PyBUF_C_CONTIGUOUS)) {
+    int size = hv->capacity();
+    if (view.len == size * sizeof(double)) {
+      memcpy(view.buf, vector_vec(hv), size * sizeof(double));
+      copied = true;
+    }
+    PyBuffer_Release(&view);
+  }
+  return copied;
+}
+
+static IvocVect* nrnpy_vec_from_buffer(void* v) {
+  Vect* hv = (Vect*)v;
+  Object* ho = *hoc_objgetarg(1);
+  if (ho->ctemplate->sym != nrnpy_pyobj_sym_) {
+    hoc_execerror(hoc_object_name(ho), " is not a PythonObject");
+  }
+  PyObject* po = nrnpy_hoc2pyobject(ho);
+  Py_buffer view;
+  if (!nrnpy_double_buffer(po, &view, PyBUF_STRIDED_RO)) {
+    hoc_execerror(hoc_object_name(ho),
+                  " is not a buffer of doubles with at most one dimension"
+                  " or C contiguous");
+  }
+  vec_from_double_buffer(hv, &view);
+  PyBuffer_Release(&view);
+  return hv;
+}
+
 static IvocVect* nrnpy_vec_from_python(void* v) {
   Vect* hv = (Vect*)v;
   //	printf("%s.from_array\n", hoc_object_name(hv->obj_));
@@ -1778,7 +1874,11 @@ static IvocVect* nrnpy_vec_from_python(void* v) {
   }
   PyObject* po = nrnpy_hoc2pyobject(ho);
   Py_INCREF(po);
-  if (!PySequence_Check(po)) {
+  Py_buffer view;
+  if (nrnpy_double_buffer(po, &view, PyBUF_STRIDED_RO)) {
+    vec_from_double_buffer(hv, &view);
+    PyBuffer_Release(&view);
+  } else if (!PySequence_Check(po)) {
     if (!PyIter_Check(po)) {
       hoc_execerror(
           hoc_object_name(ho),
@@ -1885,8 +1985,14 @@ static Object** nrnpy_vec_to_python(void* v) {
   }
   //	printf("size = %d\n", size);
   long stride;
-  char* y = double_array_interface(po, stride);
-  if (y) {
+  char* y = NULL;
+  bool copied = vec_to_double_buffer(hv, po);
+  if (!copied) {
+    y = double_array_interface(po, stride);
+  }
+  if (copied) {
+    // one memcpy into the writable buffer
+  } else if (y) {
     for (int i = 0, j = 0; i < size; ++i, j += stride) {
       *(double*)(y + j) = x[i];
     }
@@ -1913,6 +2019,95 @@ static Object** nrnpy_vec_to_python(void* v) {
   return hoc_temp_objptr(ho);
 }
 
+// PEP 3118 buffer protocol for Vector (1-d) and full Matrix (2-d).
+// The buffer shares the hoc data, so while it (e.g. a numpy array) is in
+// use the export count makes a Vector reallocation or Matrix resize an
+// error.
+static void hocobj_export(Object* ho, int incr) {
+  if (ho->ctemplate == hoc_vec_template_) {
+    ((Vect*)ho->u.this_pointer)->nexport_ += incr;
+  } else {
+    matrix_export(ho->u.this_pointer, incr);
+  }
+}
+
+static int hocobj_getbuffer(PyObject* self, Py_buffer* view, int flags) {
+  static double empty;
+  PyHocObject* pho = (PyHocObject*)self;
+  Object* ho = pho->ho_;
+  int ndim;
+  double* data;
+  Py_ssize_t shape[2], strides[2];
+  if (pho->type_ == PyHoc::HocObject && ho->ctemplate == hoc_vec_template_) {
+    Vect* vec = (Vect*)ho->u.this_pointer;
+    ndim = 1;
+    data = vector_vec(vec);
+    shape[0] = vec->capacity();
+    strides[0] = sizeof(double);
+  } else if (pho->type_ == PyHoc::HocObject &&
+             ho->ctemplate == hoc_matrix_template_ &&
+             matrix_type(ho->u.this_pointer) == 1) {
+    void* m = ho->u.this_pointer;
+    ndim = 2;
+    shape[0] = matrix_nrow(m);
+    shape[1] = matrix_ncol(m);
+    data = (shape[0] && shape[1]) ? matrix_pelm(m, 0, 0) : NULL;
+    // rows may be longer than ncol after a resize
+    strides[0] = (shape[0] > 1 && shape[1])
+                     ? (char*)matrix_pelm(m, 1, 0) - (char*)data
+                     : shape[1] * sizeof(double);
+    strides[1] = sizeof(double);
+  } else {
+    PyErr_SetString(PyExc_BufferError,
+                    "only Vector and full Matrix support the buffer protocol");
+    view->obj = NULL;
+    return -1;
+  }
+  bool contig = (ndim == 1 || shape[0] < 2 ||
+                 strides[0] == shape[1] * (Py_ssize_t)sizeof(double));
+  bool fcontig = (ndim == 1 || shape[0] < 2 || shape[1] < 2);
+  int want = flags & ~PyBUF_STRIDES &
+             (PyBUF_C_CONTIGUOUS | PyBUF_F_CONTIGUOUS | PyBUF_ANY_CONTIGUOUS);
+  if ((!contig && ((flags & PyBUF_STRIDES) != PyBUF_STRIDES || want)) ||
+      (!fcontig && want == (PyBUF_F_CONTIGUOUS & ~PyBUF_STRIDES))) {
+    PyErr_SetString(PyExc_BufferError,
+                    "Matrix data does not have the requested layout");
+    view->obj = NULL;
+    return -1;
+  }
+  // shape and strides must live until hocobj_releasebuffer
+  Py_ssize_t* ss = (Py_ssize_t*)PyMem_Malloc(4 * sizeof(Py_ssize_t));
+  if (!ss) {
+    PyErr_NoMemory();
+    view->obj = NULL;
+    return -1;
+  }
+  ss[0] = shape[0];
+  ss[1] = shape[1];
+  ss[2] = strides[0];
+  ss[3] = strides[1];
+  view->buf = data ? (void*)data : (void*)&empty;
+  view->obj = self;
+  Py_INCREF(self);
+  view->len = shape[0] * (ndim == 2 ? shape[1] : 1) * sizeof(double);
+  view->readonly = 0;
+  view->itemsize = sizeof(double);
+  view->format = (flags & PyBUF_FORMAT) ? (char*)"d" : NULL;
+  // without PyBUF_ND the consumer sees the (contiguous) data as 1-d
+  view->ndim = (flags & PyBUF_ND) == PyBUF_ND ? ndim : 1;
+  view->shape = (flags & PyBUF_ND) == PyBUF_ND ? ss : NULL;
+  view->strides = (flags & PyBUF_STRIDES) == PyBUF_STRIDES ? ss + 2 : NULL;
+  view->suboffsets = NULL;
+  view->internal = ss;
+  hocobj_export(ho, 1);
+  return 0;
+}
+
+static void hocobj_releasebuffer(PyObject* self, Py_buffer* view) {
+  hocobj_export(((PyHocObject*)self)->ho_, -1);
+  PyMem_Free(view->internal);
+}
+
 // poorly follows __reduce__ and __setstate__
 // from numpy/core/src/multiarray/methods.c
 static PyObject* hocpickle_reduce(PyObject* self, PyObject* args) {
@@ -2121,6 +2316,7 @@ char get_endian_character() {
 myPyMODINIT_FUNC nrnpy_hoc() {
   PyObject* m;
   nrnpy_vec_from_python_p_ = nrnpy_vec_from_python;
+  nrnpy_vec_from_buffer_p_ = nrnpy_vec_from_buffer;
   nrnpy_vec_to_python_p_ = nrnpy_vec_to_python;
   nrnpy_vec_as_numpy_helper_ = vec_as_numpy_helper;
   PyGILState_STATE pgs = PyGILState_Ensure();
@@ -2142,6 +2338,9 @@ myPyMODINIT_FUNC nrnpy_hoc() {
   Py_INCREF(hocobject_type);
   // printf("AddObject HocObject\n");
   PyModule_AddObject(m, "HocObject", (PyObject*)hocobject_type);
+  hocbuffer_type = &nrnpy_HocBufferType;
+  if (PyType_Ready(hocbuffer_type) < 0) goto fail;
+  Py_INCREF(hocbuffer_type);
 
   s = hoc_lookup("Vector");
   assert(s);
@@ -2156,6 +2355,7 @@ myPyMODINIT_FUNC nrnpy_hoc() {
   hoc_sectionlist_template_ = s->u.ctemplate;
   s = hoc_lookup("Matrix");
   assert(s);
+  hoc_matrix_template_ = s->u.ctemplate;
   sym_mat_x = hoc_table_lookup("x", s->u.ctemplate->symtable);
   assert(sym_mat_x);
   s = hoc_lookup("NetCon");
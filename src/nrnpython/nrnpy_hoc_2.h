@@ -52,6 +52,15 @@ static PyNumberMethods hocobj_as_number = {
 #define ccast /**/
 #endif
 
+static PyBufferProcs hocobj_as_buffer = {
+    0,                                        /* bf_getreadbuffer */
+    0,                                        /* bf_getwritebuffer */
+    0,                                        /* bf_getsegcount */
+    0,                                        /* bf_getcharbuffer */
+    (getbufferproc)hocobj_getbuffer,          /* bf_getbuffer */
+    (releasebufferproc)hocobj_releasebuffer,  /* bf_releasebuffer */
+};
+
 static PyTypeObject nrnpy_HocObjectType = {
     PyObject_HEAD_INIT(NULL)0,                /*ob_size*/
     ccast "hoc.HocObject",                    /*tp_name*/
@@ -92,3 +101,46 @@ static PyTypeObject nrnpy_HocObjectType = {
     0,                     /* tp_alloc */
     hocobj_new,            /* tp_new */
 };
+
+// Vector and full Matrix objects have this subtype of HocObject so that
+// only they export the buffer protocol (see hocobj_pytype).
+static PyTypeObject nrnpy_HocBufferType = {
+    PyObject_HEAD_INIT(NULL)0,                /*ob_size*/
+    ccast "hoc.HocBufferObject",              /*tp_name*/
+    sizeof(PyHocObject),                      /*tp_basicsize*/
+    0,                                        /*tp_itemsize*/
+    (destructor)hocobj_dealloc,               /*tp_dealloc*/
+    0,                                        /*tp_print*/
+    0,                                        /*tp_getattr*/
+    0,                                        /*tp_setattr*/
+    0,                                        /*tp_compare*/
+    hocobj_repr,                              /*tp_repr*/
+    &hocobj_as_number,                        /*tp_as_number*/
+    &hocobj_seqmeth,                          /*tp_as_sequence*/
+    0,                                        /*tp_as_mapping*/
+    (hashfunc)hocobj_hash,                    /*tp_hash */
+    (ternaryfunc)hocobj_call,                 /*tp_call*/
+    0,                                        /*tp_str*/
+    hocobj_getattro,                          /*tp_getattro*/
+    hocobj_setattro,                          /*tp_setattro*/
+    &hocobj_as_buffer,                        /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_NEWBUFFER, /*tp_flags*/
+    ccast hocobj_docstring,                   /* tp_doc */
+    0,                                        /* tp_traverse */
+    0,                                        /* tp_clear */
+    (richcmpfunc)hocobj_richcmp,              /* tp_richcompare */
+    0,                                        /* tp_weaklistoffset */
+    &hocobj_iter,                             /* tp_iter */
+    &hocobj_iternext,                         /* tp_iternext */
+    0,                     /* tp_methods */
+    0,                     /* tp_members */
+    0,                     /* tp_getset */
+    &nrnpy_HocObjectType,  /* tp_base */
+    0,                     /* tp_dict */
+    0,                     /* tp_descr_get */
+    0,                     /* tp_descr_set */
+    0,                     /* tp_dictoffset */
+    (initproc)hocobj_init, /* tp_init */
+    0,                     /* tp_alloc */
+    hocobj_new,            /* tp_new */
+};
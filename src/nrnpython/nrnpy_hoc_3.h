@@ -38,6 +38,11 @@ static PyNumberMethods hocobj_as_number = {
     0,  // unaryfunc nb_index;
 };
 
+static PyBufferProcs hocobj_as_buffer = {
+    (getbufferproc)hocobj_getbuffer,         // getbufferproc bf_getbuffer;
+    (releasebufferproc)hocobj_releasebuffer, // releasebufferproc bf_releasebuffer;
+};
+
 static PyTypeObject nrnpy_HocObjectType = {
     /* The ob_type field must be initialized in the module init function
      * to be portable to Windows without using C++. */
@@ -83,6 +88,51 @@ static PyTypeObject nrnpy_HocObjectType = {
     0,                                        /*tp_is_gc*/
 };
 
+// Vector and full Matrix objects have this subtype of HocObject so that
+// only they export the buffer protocol (see hocobj_pytype).
+static PyTypeObject nrnpy_HocBufferType = {
+    PyVarObject_HEAD_INIT(NULL, 0) "hoc.HocBufferObject", /*tp_name*/
+    sizeof(PyHocObject),                            /*tp_basicsize*/
+    0,                                              /*tp_itemsize*/
+    /* methods */
+    (destructor)hocobj_dealloc,               /*tp_dealloc*/
+    0,                                        /*tp_print*/
+    (getattrfunc)0,                           /*tp_getattr*/
+    (setattrfunc)0,                           /*tp_setattr*/
+    0,                                        /*tp_reserved*/
+    (reprfunc)hocobj_repr,                    /*tp_repr*/
+    &hocobj_as_number,                        /*tp_as_number*/
+    &hocobj_seqmeth,                          /*tp_as_sequence*/
+    0,                                        /*tp_as_mapping*/
+    (hashfunc)hocobj_hash,                    /*tp_hash*/
+    (ternaryfunc)hocobj_call,                 /*tp_call*/
+    0,                                        /*tp_str*/
+    hocobj_getattro,                          /*tp_getattro*/
+    hocobj_setattro,                          /*tp_setattro*/
+    &hocobj_as_buffer,                        /*tp_as_buffer*/
+    Py_TPFLAGS_DEFAULT,                       /*tp_flags*/
+    hocobj_docstring,                         /*tp_doc*/
+    0,                                        /*tp_traverse*/
+    0,                                        /*tp_clear*/
+    (richcmpfunc)hocobj_richcmp,              /*tp_richcompare*/
+    0,                                        /*tp_weaklistoffset*/
+    &hocobj_iter,                             /*tp_iter*/
+    &hocobj_iternext,                         /*tp_iternext*/
+    0,                                        /*tp_methods*/
+    0,                                        /*tp_members*/
+    0,                                        /*tp_getset*/
+    &nrnpy_HocObjectType,                     /*tp_base*/
+    0,                                        /*tp_dict*/
+    0,                                        /*tp_descr_get*/
+    0,                                        /*tp_descr_set*/
+    0,                                        /*tp_dictoffset*/
+    (initproc)hocobj_init,                    /*tp_init*/
+    0,                                        /*tp_alloc*/
+    hocobj_new,                               /*tp_new*/
+    0,                                        /*tp_free*/
+    0,                                        /*tp_is_gc*/
+};
+
 static struct PyModuleDef hocmodule = {PyModuleDef_HEAD_INIT, "hoc",
                                        "HOC interaction with Python", -1,
                                        HocMethods, NULL, NULL, NULL, NULL};
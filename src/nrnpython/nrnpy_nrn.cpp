@@ -2,6 +2,7 @@
 #include <structmember.h>
 #include <InterViews/resource.h>
 #include <nrnoc2iv.h>
+#include "ivocvect.h"
 #include "nrnpy_utils.h"
 
 extern "C" {
@@ -76,6 +77,8 @@ extern Symbol* nrnpy_pyobj_sym_;
 extern int nrnpy_ho_eq_po(Object*, PyObject*);
 extern PyObject* nrnpy_hoc2pyobject(Object*);
 extern PyObject* nrnpy_ho2po(Object*);
+extern bool nrnpy_double_buffer(PyObject*, Py_buffer*, int);
+extern Object* hoc_newobj1(Symbol*, int);
 static void nrnpy_reg_mech(int);
 extern void (*nrnpy_reg_mech_p_)(int);
 static void o2loc(Object*, Section**, double*);
@@ -1532,6 +1535,242 @@ static PyMemberDef NPyMechObj_members[] = {{NULL}};
 static PySequenceMethods rv_seqmeth = {
     rv_len, NULL, NULL, rv_getitem, NULL, rv_setitem, NULL, NULL, NULL, NULL};
 
+// Sections for the bulk range variable access below. None means all
+// sections, otherwise a Section, a SectionList, or an iterable of Sections.
+static Section** rangevar_sections(PyObject* po, int* cnt) {
+  hoc_Item* q, * ql = NULL;
+  Section** secs;
+  int n = 0;
+  *cnt = 0;
+  if (po == NULL || po == Py_None) {
+    ql = section_list;
+  } else if (PyObject_TypeCheck(po, psection_type)) {
+    secs = new Section*[1];
+    secs[0] = ((NPySecObj*)po)->sec_;
+    *cnt = 1;
+    return secs;
+  } else {
+    Object* ho = nrnpy_po2ho(po);
+    if (ho->ctemplate->sym == hoc_table_lookup("SectionList",
+                                               hoc_built_in_symlist)) {
+      ql = (hoc_Item*)ho->u.this_pointer;
+    }
+    hoc_obj_unref(ho);
+  }
+  if (ql) {
+    ITERATE(q, ql) {
+      ++n;
+    }
+    secs = new Section*[n];
+    ITERATE(q, ql) {
+      Section* sec = hocSEC(q);
+      if (sec->prop) {
+        secs[(*cnt)++] = sec;
+      }
+    }
+    return secs;
+  }
+  PyObject* seq = PySequence_Fast(po, "sections must be None, a Section, a "
+                                      "SectionList, or a sequence of Sections");
+  if (!seq) {
+    return NULL;
+  }
+  n = PySequence_Fast_GET_SIZE(seq);
+  PyObject** items = PySequence_Fast_ITEMS(seq);
+  secs = new Section*[n];
+  for (int i = 0; i < n; ++i) {
+    PyObject* item = items[i];
+    if (!PyObject_TypeCheck(item, psection_type)) {
+      PyErr_SetString(PyExc_TypeError, "sequence item is not a Section");
+      Py_DECREF(seq);
+      delete[] secs;
+      return NULL;
+    }
+    Section* sec = ((NPySecObj*)item)->sec_;
+    if (!sec->prop) {
+      PyErr_SetString(PyExc_ReferenceError, "can't access a deleted section");
+      Py_DECREF(seq);
+      delete[] secs;
+      return NULL;
+    }
+    secs[(*cnt)++] = sec;
+  }
+  Py_DECREF(seq);
+  return secs;
+}
+
+// Pointers to the range variable at the segment centers of the sections
+// in section order. Mechanism parameters are taken from the Prop param
+// array, i.e. the Memb_list row of that segment, without the name lookup
+// done for each segment by segment_getattro.
+static double** rangevar_pointers(PyObject* pyname, PyObject* sections,
+                                  Symbol** psym, Section*** psecs, int* pnsec,
+                                  int* pn) {
+  Py2NRNString name(pyname);
+  char* n = name.c_str();
+  PyObject* rv;
+  if (!n || (rv = PyDict_GetItemString(rangevars_, n)) == NULL) {
+    PyErr_SetString(PyExc_NameError, n ? n : "name must be a string");
+    return NULL;
+  }
+  Symbol* sym = ((NPyRangeVar*)rv)->sym_;
+  if (ISARRAY(sym)) {
+    char buf[200];
+    sprintf(buf, "%s is an array range variable", sym->name);
+    PyErr_SetString(PyExc_TypeError, buf);
+    return NULL;
+  }
+  int nsec;
+  Section** secs = rangevar_sections(sections, &nsec);
+  if (!secs) {
+    return NULL;
+  }
+  int cnt = 0;
+  for (int i = 0; i < nsec; ++i) {
+    cnt += secs[i]->nnode - 1;
+  }
+  double** pd = new double*[cnt > 0 ? cnt : 1];
+  int type = sym->u.rng.type;
+  int index = sym->u.rng.index;
+  bool direct = type > EXTRACELL && sym->subtype != NRNPOINTER;
+  int k = 0;
+  for (int i = 0; i < nsec; ++i) {
+    Section* sec = secs[i];
+    int nseg = sec->nnode - 1;
+    if (sec->recalc_area_ && type == MORPHOLOGY) {
+      nrn_area_ri(sec);
+    }
+    for (int j = 0; j < nseg; ++j, ++k) {
+      double x = (double(j) + 0.5) / double(nseg);
+      int err = 1;
+      if (direct) {
+        // node_index, not j, since the node order is reversed for a
+        // section connected at its 1 end
+        Prop* p = nrn_mechanism(type, sec->pnode[node_index(sec, x)]);
+        pd[k] = p ? (p->ob ? p->ob->u.dataspace[index].pval : p->param + index)
+                  : NULL;
+      } else {
+        pd[k] = nrnpy_rangepointer(sec, sym, x, &err);
+      }
+      if (!pd[k]) {
+        rv_noexist(sec, sym->name, x, err);
+        delete[] pd;
+        delete[] secs;
+        return NULL;
+      }
+    }
+  }
+  *psym = sym;
+  *psecs = secs;
+  *pnsec = nsec;
+  *pn = cnt;
+  return pd;
+}
+
+static PyObject* nrnpy_rangevar_get(PyObject* self, PyObject* args) {
+  PyObject* pyname;
+  PyObject* sections = NULL;
+  if (!PyArg_ParseTuple(args, "O|O", &pyname, &sections)) {
+    return NULL;
+  }
+  Symbol* sym;
+  Section** secs;
+  int nsec, n;
+  double** pd = rangevar_pointers(pyname, sections, &sym, &secs, &nsec, &n);
+  if (!pd) {
+    return NULL;
+  }
+  Object* ho = hoc_newobj1(hoc_lookup("Vector"), 0);
+  Vect* vec = (Vect*)ho->u.this_pointer;
+  vector_resize(vec, n);
+  double* x = vector_vec(vec);
+  for (int i = 0; i < n; ++i) {
+    x[i] = *pd[i];
+  }
+  delete[] pd;
+  delete[] secs;
+  PyObject* result = nrnpy_ho2po(ho);
+  hoc_obj_unref(ho);
+  return result;
+}
+
+static PyObject* nrnpy_rangevar_set(PyObject* self, PyObject* args) {
+  PyObject* pyname;
+  PyObject* values;
+  PyObject* sections = NULL;
+  if (!PyArg_ParseTuple(args, "OO|O", &pyname, &values, &sections)) {
+    return NULL;
+  }
+  Symbol* sym;
+  Section** secs;
+  int nsec, n;
+  double** pd = rangevar_pointers(pyname, sections, &sym, &secs, &nsec, &n);
+  if (!pd) {
+    return NULL;
+  }
+  Py_buffer view;
+  PyObject* seq = NULL;
+  int err = 0;
+  if (PyNumber_Check(values) && !PyObject_CheckBuffer(values)) {
+    double x = PyFloat_AsDouble(values);
+    if (x == -1. && PyErr_Occurred()) {
+      err = 1;
+    } else {
+      for (int i = 0; i < n; ++i) {
+        *pd[i] = x;
+      }
+    }
+  } else if (nrnpy_double_buffer(values, &view, PyBUF_STRIDED_RO)) {
+    if (view.len != Py_ssize_t(n * sizeof(double))) {
+      err = 2;
+    } else {
+      char* y = (char*)view.buf;
+      Py_ssize_t stride = view.ndim == 1 ? view.strides[0] : sizeof(double);
+      for (int i = 0; i < n; ++i, y += stride) {
+        *pd[i] = *(double*)y;
+      }
+    }
+    PyBuffer_Release(&view);
+  } else if ((seq = PySequence_Fast(values, "values must be a number, a "
+                                            "buffer of doubles, or a "
+                                            "sequence")) == NULL) {
+    err = 1;
+  } else if (PySequence_Fast_GET_SIZE(seq) != n) {
+    err = 2;
+  } else {
+    PyObject** items = PySequence_Fast_ITEMS(seq);
+    for (int i = 0; i < n; ++i) {
+      double x = PyFloat_AsDouble(items[i]);
+      if (x == -1. && PyErr_Occurred()) {
+        err = 1;
+        break;
+      }
+      *pd[i] = x;
+    }
+  }
+  Py_XDECREF(seq);
+  if (err == 2) {
+    char buf[200];
+    sprintf(buf, "need %d values for %s", n, sym->name);
+    PyErr_SetString(PyExc_ValueError, buf);
+  }
+  if (err != 2 && sym->u.rng.type == MORPHOLOGY) {
+    diam_changed = 1;
+    for (int i = 0; i < nsec; ++i) {
+      secs[i]->recalc_area_ = 1;
+      nrn_diam_change(secs[i]);
+    }
+  } else if (sym->u.rng.type == EXTRACELL && sym->u.rng.index == 0) {
+    diam_changed = 1;
+  }
+  delete[] pd;
+  delete[] secs;
+  if (err) {
+    return NULL;
+  }
+  return Py_BuildValue("");
+}
+
 PyObject* nrnpy_cas(PyObject* self, PyObject* args) {
   Section* sec = chk_access();
   // printf("nrnpy_cas %s\n", secname(sec));
@@ -1542,6 +1781,12 @@ static PyMethodDef nrnpy_methods[] = {
     {"cas", nrnpy_cas, METH_VARARGS, "Return the currently accessed section."},
     {"allsec", nrnpy_forall, METH_VARARGS,
      "Return iterator over all sections."},
+    {"rangevar_get", nrnpy_rangevar_get, METH_VARARGS,
+     "rangevar_get(name[, sections]) returns a Vector of the named range "
+     "variable at every segment of the sections (default all)."},
+    {"rangevar_set", nrnpy_rangevar_set, METH_VARARGS,
+     "rangevar_set(name, values[, sections]) assigns a number, or a buffer "
+     "or sequence with one value per segment, to the named range variable."},
     {NULL}};
 
 #if PY_MAJOR_VERSION >= 3
@@ -931,6 +931,41 @@ void connect_obsec_syntax(void) {
 
 #endif
 
+/* Each hoc_object_component call site caches the template id and member
+   symbol of its last lookup (see ptid and psym below). A site that sees
+   objects of several templates, e.g. iterating over a List of different
+   cell types, would otherwise do a linear search of the template symbol
+   table on every execution. This small direct mapped cache, indexed by
+   the member name symbol and the template id, catches those. Templates
+   cannot be redefined so an entry can only be stale if the name symbol
+   was freed, hence the name comparison.
+*/
+#define OBCOMP_CACHE_SIZE 512
+static struct {
+	Symbol* name;
+	Symbol* sym;
+	int tid;
+} obcomp_cache_[OBCOMP_CACHE_SIZE];
+
+static Symbol* obcomp_lookup(Symbol* sym0, Template* t) {
+	Symbol* sym;
+	unsigned long h = ((unsigned long)sym0 >> 4) ^ (unsigned long)(t->id * 31);
+	h %= OBCOMP_CACHE_SIZE;
+	if (obcomp_cache_[h].name == sym0 && obcomp_cache_[h].tid == t->id
+	    && strcmp(obcomp_cache_[h].sym->name, sym0->name) == 0) {
+		return obcomp_cache_[h].sym;
+	}
+	sym = hoc_table_lookup(sym0->name, t->symtable);
+	if (!sym || sym->public != PUBLIC_TYPE) {
+fprintf(stderr, "%s not a public member of %s\n", sym0->name, t->sym->name);
+hoc_execerror(t->sym->name, sym0->name);
+	}
+	obcomp_cache_[h].name = sym0;
+	obcomp_cache_[h].tid = t->id;
+	obcomp_cache_[h].sym = sym;
+	return sym;
+}
+
 void hoc_object_component(void) { /* number of indices at pc+2, number of args at pc+3,
 				 symbol at pc+1 */
 			/* object pointer on stack after indices */
@@ -1005,11 +1040,7 @@ hoc_execerror("Cannot assign to a PythonObject function call:", sym0->name);
 		    if (obp->aliases == 0 || (sym = ivoc_alias_lookup(sym0->name, obp)) == 0) {
 			/* lookup only has to be done once if the name is not an alias
 			and the ptid of the object is still the same. */
-			sym = hoc_table_lookup(sym0->name, obp->template->symtable);
-			if (!sym || sym->public != PUBLIC_TYPE) {
-fprintf(stderr, "%s not a public member of %s\n", sym0->name, obp->template->sym->name);
-hoc_execerror(obp->template->sym->name, sym0->name);
-			}
+			sym = obcomp_lookup(sym0, obp->template);
 			*ptid = obp->template->id;
 			*psym = sym;
 		    }
@@ -131,3 +131,183 @@ double nrnran123_uint2dbl(uint32_t u) {
 	/* min 2.3283064e-10 to max (1 - 2.3283064e-10) */
 	return ((double)u + 1.0) * SHIFT32;
 }
+
+/* Bulk draws. Uniforms are generated a chunk at a time and then
+   transformed in a separate loop, so the transforms are simple loops over
+   arrays. Normal deviates use the Box-Muller transform, which, unlike the
+   polar rejection method of nrnran123_normal, uses a fixed number of
+   uniforms per value.
+*/
+#define RAN123_CHUNK 256
+static const double twopi = 6.283185307179586;
+
+/* Philox4x32-10 of up to RAN123_LANES counters at once. w[i][j] is word i
+   of counter j and is replaced by word i of the result. Each round is a
+   loop over independent lanes, which the compiler can turn into SIMD
+   instructions. Same values as philox4x32 with the global key.
+*/
+#define RAN123_LANES 16
+typedef uint32_t ran123_lanes[4][RAN123_LANES];
+
+static void philox_lanes(ran123_lanes w, int n) {
+	uint32_t k0 = k.v[0], k1 = k.v[1];
+	int r, j;
+	for (r=0; r < PHILOX4x32_DEFAULT_ROUNDS; ++r) {
+		for (j=0; j < n; ++j) {
+			uint64_t p0 = (uint64_t)PHILOX_M4x32_0 * w[0][j];
+			uint64_t p1 = (uint64_t)PHILOX_M4x32_1 * w[2][j];
+			uint32_t w1 = w[1][j];
+			uint32_t w3 = w[3][j];
+			w[0][j] = (uint32_t)(p1 >> 32) ^ w1 ^ k0;
+			w[1][j] = (uint32_t)p1;
+			w[2][j] = (uint32_t)(p0 >> 32) ^ w3 ^ k1;
+			w[3][j] = (uint32_t)p0;
+		}
+		k0 += PHILOX_W32_0;
+		k1 += PHILOX_W32_1;
+	}
+}
+
+static void ran123_transform(int dist, double* u, double* x, int n) {
+	int i;
+	switch (dist) {
+	case NRNRAN123_UNIFORM:
+		for (i=0; i < n; ++i) { x[i] = u[i]; }
+		break;
+	case NRNRAN123_NEGEXP:
+		for (i=0; i < n; ++i) { x[i] = -log(u[i]); }
+		break;
+	case NRNRAN123_NORMAL:
+		/* u holds n (rounded up to even) uniforms, two per pair of x */
+		for (i=0; i < n - 1; i += 2) {
+			double r = sqrt(-2.*log(u[i]));
+			double a = twopi*u[i+1];
+			x[i] = r*cos(a);
+			x[i+1] = r*sin(a);
+		}
+		if (i < n) {
+			x[i] = sqrt(-2.*log(u[i]))*cos(twopi*u[i+1]);
+		}
+		break;
+	default:
+		hoc_execerror("nrnran123: unknown distribution", (char*)0);
+	}
+}
+
+void nrnran123_array(nrnran123_State* s, int dist, double* x, int n) {
+	double u[RAN123_CHUNK];
+	ran123_lanes w;
+	philox4x32_ctr_t c = s->c;
+	int i, j, l, m, nu, nb;
+	if (s->which_) {
+		c.v[0]++;
+	}
+	for (i=0; i < n; i += m) {
+		m = (n - i < RAN123_CHUNK) ? n - i : RAN123_CHUNK;
+		nu = m + (m & 1); /* normal needs an even number of uniforms */
+		for (j=0; j < nu; j += 4*nb) {
+			nb = (nu - j + 3)/4;
+			if (nb > RAN123_LANES) {
+				nb = RAN123_LANES;
+			}
+			for (l=0; l < nb; ++l) {
+				w[0][l] = c.v[0] + l;
+				w[1][l] = c.v[1];
+				w[2][l] = c.v[2];
+				w[3][l] = c.v[3];
+			}
+			c.v[0] += nb;
+			philox_lanes(w, nb);
+			for (l=0; l < nb; ++l) {
+				double* ul = u + j + 4*l;
+				ul[0] = nrnran123_uint2dbl(w[0][l]);
+				ul[1] = nrnran123_uint2dbl(w[1][l]);
+				ul[2] = nrnran123_uint2dbl(w[2][l]);
+				ul[3] = nrnran123_uint2dbl(w[3][l]);
+			}
+		}
+		ran123_transform(dist, u, x + i, m);
+	}
+	nrnran123_setseq(s, c.v[0], 0);
+}
+
+void nrnran123_streams(uint32_t seq, const uint32_t* id1, uint32_t id2,
+  uint32_t id3, int dist, double* x, int n) {
+	double u[2*RAN123_CHUNK];
+	ran123_lanes w;
+	int i, j, l, m, nb;
+	for (i=0; i < n; i += m) {
+		m = (n - i < RAN123_CHUNK) ? n - i : RAN123_CHUNK;
+		for (j=0; j < m; j += nb) {
+			nb = (m - j < RAN123_LANES) ? m - j : RAN123_LANES;
+			for (l=0; l < nb; ++l) {
+				w[0][l] = seq;
+				w[1][l] = id3;
+				w[2][l] = id1[i + j + l];
+				w[3][l] = id2;
+			}
+			philox_lanes(w, nb);
+			for (l=0; l < nb; ++l) {
+				u[2*(j+l)] = nrnran123_uint2dbl(w[0][l]);
+				u[2*(j+l)+1] = nrnran123_uint2dbl(w[1][l]);
+			}
+		}
+		if (dist == NRNRAN123_NORMAL) {
+			double* y = x + i;
+			for (j=0; j < m; ++j) {
+				y[j] = sqrt(-2.*log(u[2*j]))*cos(twopi*u[2*j+1]);
+			}
+		}else{
+			for (j=0; j < m; ++j) {
+				u[j] = u[2*j];
+			}
+			ran123_transform(dist, u, x + i, m);
+		}
+	}
+}
+
+/* the next block of each stream, computed in lanes */
+static void ran123_refill(nrnran123_State** s, int n) {
+	ran123_lanes w;
+	int i, j;
+	for (j=0; j < n; ++j) {
+		for (i=0; i < 4; ++i) {
+			w[i][j] = s[j]->c.v[i];
+		}
+	}
+	philox_lanes(w, n);
+	for (j=0; j < n; ++j) {
+		for (i=0; i < 4; ++i) {
+			s[j]->r.v[i] = w[i][j];
+		}
+	}
+}
+
+void nrnran123_dblpick_streams(nrnran123_State** s, double* x, int n) {
+	nrnran123_State* refill[RAN123_LANES];
+	int i, nr = 0;
+	for (i=0; i < n; ++i) {
+		nrnran123_State* p = s[i];
+		x[i] = nrnran123_uint2dbl(p->r.v[(int)p->which_]);
+		if (++p->which_ > 3) {
+			p->which_ = 0;
+			p->c.v[0]++;
+			refill[nr++] = p;
+			if (nr == RAN123_LANES) {
+				ran123_refill(refill, nr);
+				nr = 0;
+			}
+		}
+	}
+	if (nr) {
+		ran123_refill(refill, nr);
+	}
+}
+
+void nrnran123_negexp_streams(nrnran123_State** s, double* x, int n) {
+	int i;
+	nrnran123_dblpick_streams(s, x, n);
+	for (i=0; i < n; ++i) {
+		x[i] = -log(x[i]);
+	}
+}
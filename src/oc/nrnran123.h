@@ -55,6 +55,23 @@ extern double nrnran123_negexp(nrnran123_State*);  /* mean 1.0 */
     /* nrnran123_negexp min value is 2.3283064e-10, max is 22.18071 */
 extern double nrnran123_normal(nrnran123_State*); /* mean 0.0, std 1.0 */
 
+/* bulk draws. dist is one of the following standard distributions */
+#define NRNRAN123_UNIFORM 0 /* open interval (0,1) */
+#define NRNRAN123_NEGEXP 1 /* mean 1.0 */
+#define NRNRAN123_NORMAL 2 /* mean 0.0, std 1.0 */
+/* n values from one stream, starting at the next unused counter block.
+   Every word of a block is used. The stream is left at the following block. */
+extern void nrnran123_array(nrnran123_State*, int dist, double* x, int n);
+/* x[i] from block seq of stream (id1[i], id2, id3), i.e. one value per
+   stream. The result does not depend on how streams are grouped into calls. */
+extern void nrnran123_streams(uint32_t seq, const uint32_t* id1, uint32_t id2,
+  uint32_t id3, int dist, double* x, int n);
+/* x[i] = nrnran123_dblpick(s[i]) (or nrnran123_negexp(s[i])) for n
+   distinct streams, e.g. one per mechanism instance in a time step.
+   Streams that need a new counter block are computed together. */
+extern void nrnran123_dblpick_streams(nrnran123_State** s, double* x, int n);
+extern void nrnran123_negexp_streams(nrnran123_State** s, double* x, int n);
+
 /* more fundamental (stateless) (though the global index is still used) */
 extern nrnran123_array4x32 nrnran123_iran(uint32_t seq, uint32_t id1, uint32_t id2);
 extern nrnran123_array4x32 nrnran123_iran3(uint32_t seq, uint32_t id1, uint32_t id2, uint32_t id3);
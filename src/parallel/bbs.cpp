@@ -23,6 +23,9 @@ static clock_t starttime;
 extern "C" {
 	extern int nrn_global_argc;
 	extern char** nrn_global_argv;
+#if !NRNMPI
+	extern double nrnmpi_wtime();
+#endif
 };
 
 bool BBSImpl::is_master_ = false;
@@ -178,7 +181,7 @@ double BBSImpl::time() {
 #ifdef HAVE_TMS
 	return double(times(&tmsbuf))/100.;
 #else
-	return 0.;
+	return nrnmpi_wtime();
 #endif
 #endif
 }
@@ -61,6 +61,8 @@ public:
 	Object** gid2obj(int);
 	Object** gid2cell(int);
 	Object** gid_connect(int);
+	int gid_connect_bulk(IvocVect* srcgid, Object* targetlist,
+		IvocVect* tarindex, IvocVect* weight, IvocVect* delay);
 	double netpar_mindelay(double maxdelay);
 	void netpar_spanning_statistics(int*, int*, int*, int*);
 	IvocVect* netpar_max_histogram(IvocVect*);
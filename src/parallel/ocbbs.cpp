@@ -479,6 +479,58 @@ static double mech_time(void* v) {
 	return 0;
 }
 
+// profile(on) starts (and zeroes) or stops the per thread, per mechanism
+// hot path timers. See the NRN_PROF_ kinds in multicore.h
+static double profile(void* v) {
+	int was = nrn_prof_on_;
+	if (chkarg(1, 0, 1) != 0.) {
+		nrn_prof_alloc(nrn_nthread, n_memb_func);
+		nrn_prof_on_ = 1;
+	}else{
+		nrn_prof_stop();
+	}
+	return double(was);
+}
+
+// seconds for kind (summed over types if type < 0 and over threads if
+// ithread < 0)
+static double prof_sum(int kind, int type, int ith) {
+	unsigned long long sum = 0;
+	int i0 = ith < 0 ? 0 : ith, i1 = ith < 0 ? nrn_prof_nthread_ : ith + 1;
+	int j0 = type < 0 ? 0 : type, j1 = type < 0 ? nrn_prof_ntype_ : type + 1;
+	if (i1 > nrn_prof_nthread_) { i1 = nrn_prof_nthread_; }
+	if (j1 > nrn_prof_ntype_) { j1 = nrn_prof_ntype_; }
+	for (int i = i0; i < i1; ++i) {
+		unsigned long long* p = nrn_prof_[i] + kind*nrn_prof_ntype_;
+		for (int j = j0; j < j1; ++j) {
+			sum += p[j];
+		}
+	}
+	return double(sum) * nrn_prof_tick2sec();
+}
+
+static double profile_time(void* v) {
+	int kind = int(chkarg(1, 0, NRN_PROF_NKIND - 1));
+	int type = ifarg(2) ? int(chkarg(2, -1, n_memb_func - 1)) : -1;
+	int ith = ifarg(3) ? int(chkarg(3, -1, nrn_nthread - 1)) : -1;
+	return prof_sum(kind, type, ith);
+}
+
+// profile_vec(vec, kind[, ithread]) vec[type] = seconds, returns the total
+static double profile_vec(void* v) {
+	Vect* vec = vector_arg(1);
+	int kind = int(chkarg(2, 0, NRN_PROF_NKIND - 1));
+	int ith = ifarg(3) ? int(chkarg(3, -1, nrn_nthread - 1)) : -1;
+	vector_resize(vec, n_memb_func);
+	double* px = vector_vec(vec);
+	double total = 0.;
+	for (int j = 0; j < n_memb_func; ++j) {
+		px[j] = prof_sum(kind, j, ith);
+		total += px[j];
+	}
+	return total;
+}
+
 static double prcellstate(void* v) {
 	nrn_prcellstate(int(*hoc_getarg(1)), hoc_gargstr(2));
 	return 0;
@@ -946,6 +998,15 @@ static Object** gid_connect(void* v) {
 	return bbs->gid_connect(int(chkarg(1, 0, MD)));
 }
 
+static double gid_connect_bulk(void* v) {
+	OcBBS* bbs = (OcBBS*)v;
+	IvocVect* srcgid = vector_arg(1);
+	Object* o = *hoc_objgetarg(2);
+	check_obj_type(o, "List");
+	return double(bbs->gid_connect_bulk(srcgid, o, vector_arg(3),
+		vector_arg(4), vector_arg(5)));
+}
+
 static Member_func members[] = {
 	"submit", submit,
 	"working", working,
@@ -979,6 +1040,9 @@ static Member_func members[] = {
 	"integ_time", integ_time,
 	"vtransfer_time", vtransfer_time,
 	"mech_time", mech_time,
+	"profile", profile,
+	"profile_time", profile_time,
+	"profile_vec", profile_vec,
 	"timeout", set_timeout,
 
 	"set_gid2node", set_gid2node,
@@ -986,6 +1050,7 @@ static Member_func members[] = {
 	"outputcell", outputcell,
 	"cell", cell,
 	"threshold", threshold,
+	"gid_connect_bulk", gid_connect_bulk,
 	"spike_record", spike_record,
 	"psolve", psolve,
 	"set_maxstep", set_maxstep,